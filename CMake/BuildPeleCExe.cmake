@@ -144,6 +144,7 @@ function(build_pelec_exe pelec_exe_name)
        ${SRC_DIR}/Diffterm.cpp
        ${SRC_DIR}/Diffusion.H
        ${SRC_DIR}/Diffusion.cpp
+       ${SRC_DIR}/DiffusionRKL.cpp
        ${SRC_DIR}/External.cpp
        ${SRC_DIR}/Filter.H
        ${SRC_DIR}/Filter.cpp
@@ -160,10 +161,13 @@ function(build_pelec_exe pelec_exe_name)
        ${SRC_DIR}/PPM.cpp
        ${SRC_DIR}/IndexDefines.H
        ${SRC_DIR}/IndexDefines.cpp
+       ${SRC_DIR}/ImplicitDiffusion.cpp
        ${SRC_DIR}/IO.H
        ${SRC_DIR}/IO.cpp
        ${SRC_DIR}/LES.H
        ${SRC_DIR}/LES.cpp
+       ${SRC_DIR}/LevelBuffers.H
+       ${SRC_DIR}/LevelBuffers.cpp
        ${SRC_DIR}/MOL.H
        ${SRC_DIR}/MOL.cpp
        ${SRC_DIR}/Particle.cpp
@@ -178,13 +182,18 @@ function(build_pelec_exe pelec_exe_name)
        ${SRC_DIR}/SumUtils.cpp
        ${SRC_DIR}/Tagging.H
        ${SRC_DIR}/Tagging.cpp
+       ${SRC_DIR}/Telemetry.cpp
        ${SRC_DIR}/Timestep.H
+       ${SRC_DIR}/TransportTable.H
+       ${SRC_DIR}/TransportTable.cpp
        ${SRC_DIR}/Utilities.H
        ${SRC_DIR}/Utilities.cpp
        ${SRC_DIR}/WENO.H
+       ${SRC_DIR}/WorkEstimate.cpp
   )
 
-  if(NOT "${pelec_exe_name}" STREQUAL "PeleC-UnitTests")
+  if(NOT "${pelec_exe_name}" STREQUAL "PeleC-UnitTests" AND
+     NOT "${pelec_exe_name}" STREQUAL "PeleC-Benchmarks")
     target_sources(${pelec_exe_name}
        PRIVATE
          ${SRC_DIR}/main.cpp
@@ -0,0 +1,88 @@
+/** \file bench-diffusion.cpp
+ *
+ *  Benchmarks of the diffusion kernels: the transport coefficients and the
+ *  diffusion fluxes, with the coefficients computed beforehand at the cell
+ *  centers or on the faces in the flux kernel
+ */
+
+#include "Benchmark.H"
+#include "Diffterm.H"
+#include "PeleC.H"
+#include "TransportTable.H"
+
+namespace pelec_benchmarks {
+
+void
+bench_diffusion(const BenchmarkContext& ctx)
+{
+  // Cells of the state and of the fluxes, as in getMOLSrcTerm
+  const amrex::Box& bx = ctx.geom.Domain();
+  const int ng = 4;
+  const amrex::Box gbox = amrex::grow(bx, ng);
+  const amrex::Box cbox = amrex::grow(bx, ng - 1);
+  const amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> dx =
+    ctx.geom.CellSizeArray();
+  const int nCompTr = dComp_lambda + 1;
+  const TransportTable no_table;
+
+  amrex::FArrayBox S(gbox, NVAR);
+  amrex::FArrayBox q(gbox, QVAR);
+  amrex::FArrayBox qaux(gbox, NQAUX);
+  amrex::FArrayBox coef(gbox, nCompTr);
+  fill_state(ctx.geom, S);
+  fill_primitives(S, q, qaux);
+  const auto qarr = q.const_array();
+
+  run_benchmark(
+    ctx, "pc_get_transport_coeffs", gbox.numPts(),
+    nbytes(gbox, NUM_SPECIES + 2 + nCompTr),
+    [&]() { fill_transport_coeffs(q, coef); });
+
+  amrex::GpuArray<amrex::FArrayBox, AMREX_SPACEDIM> area;
+  fill_areas(ctx.geom, cbox, area);
+  amrex::FArrayBox flux[AMREX_SPACEDIM];
+  amrex::Real flux_bytes = 0.0;
+  for (int dir = 0; dir < AMREX_SPACEDIM; dir++) {
+    flux[dir].resize(amrex::surroundingNodes(cbox, dir), NVAR);
+    flux[dir].setVal<amrex::RunOn::Device>(0.0);
+    flux_bytes += nbytes(flux[dir].box(), NVAR + 1);
+  }
+  const amrex::GpuArray<amrex::Array4<amrex::Real>, AMREX_SPACEDIM> flx{
+    {AMREX_D_DECL(flux[0].array(), flux[1].array(), flux[2].array())}};
+  const amrex::GpuArray<const amrex::Array4<const amrex::Real>, AMREX_SPACEDIM>
+    area_arr{{AMREX_D_DECL(
+      area[0].const_array(), area[1].const_array(), area[2].const_array())}};
+  const auto coe_cc = coef.const_array();
+#ifdef PELEC_USE_EB
+  amrex::FArrayBox vfrac(gbox, 1);
+  amrex::EBCellFlagFab flags(gbox);
+  fill_regular_geometry(vfrac, flags);
+#endif
+
+  run_benchmark(
+    ctx, "pc_compute_diffusion_flux", cbox.numPts(),
+    nbytes(gbox, QVAR + nCompTr) + flux_bytes, [&]() {
+      pc_compute_diffusion_flux(
+        cbox, qarr, coe_cc, flx, area_arr, dx, 1, nullptr, no_table
+#ifdef PELEC_USE_EB
+        ,
+        amrex::FabType::regular, 0, nullptr, flags.const_array()
+#endif
+      );
+    });
+
+  run_benchmark(
+    ctx, "pc_compute_diffusion_flux_fused", cbox.numPts(),
+    nbytes(gbox, QVAR) + flux_bytes, [&]() {
+      pc_compute_diffusion_flux(
+        cbox, qarr, amrex::Array4<const amrex::Real>(), flx, area_arr, dx, 1,
+        pele::physics::transport::trans_parm_g, no_table
+#ifdef PELEC_USE_EB
+        ,
+        amrex::FabType::regular, 0, nullptr, flags.const_array()
+#endif
+      );
+    });
+}
+
+} // namespace pelec_benchmarks
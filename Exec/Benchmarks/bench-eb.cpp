@@ -0,0 +1,154 @@
+/** \file bench-eb.cpp
+ *
+ *  Benchmarks of the embedded boundary kernels on the cut cells of a sphere:
+ *  the boundary gradient stencils, their application to the EB heat and
+ *  viscous fluxes, and the redistribution of the source terms
+ */
+
+#include <algorithm>
+
+#include "AMReX_EB2.H"
+#include "AMReX_EB2_IF.H"
+#include "AMReX_EBFabFactory.H"
+#include "AMReX_MultiFab.H"
+#include "Benchmark.H"
+#include "EB.H"
+#include "PeleC.H"
+#include "iamr_redistribution.H"
+
+namespace pelec_benchmarks {
+
+void
+bench_eb(const BenchmarkContext& ctx)
+{
+  // Ghost cells of the state, as PeleC::numGrow() with state redistribution
+  const int ng = 5;
+  const amrex::Box& bx = ctx.geom.Domain();
+  const amrex::Box cbox = amrex::grow(bx, ng - 1);
+  const amrex::Box ebfluxbox = amrex::grow(bx, 2);
+  const int nCompTr = dComp_lambda + 1;
+
+  // Sphere of radius 0.3 in the middle of the unit box, with the fluid
+  // outside
+  amrex::EB2::SphereIF sphere(0.3, {AMREX_D_DECL(0.5, 0.5, 0.5)}, false);
+  auto gshop = amrex::EB2::makeShop(sphere);
+  amrex::EB2::Build(gshop, ctx.geom, 0, 0);
+
+  const amrex::BoxArray ba(bx);
+  const amrex::DistributionMapping dm(ba);
+  const auto factory = amrex::makeEBFabFactory(
+    ctx.geom, ba, dm, {ng, ng, ng}, amrex::EBSupport::full);
+  const auto& flags = factory->getMultiEBCellFlagFab();
+  const auto& vfrac = factory->getVolFrac();
+  const auto& bndrycent = factory->getBndryCent();
+  const auto& centroid = factory->getCentroid();
+  const auto areafrac = factory->getAreaFrac();
+  const auto facecent = factory->getFaceCent();
+
+  amrex::MultiFab S(ba, dm, NVAR, ng, amrex::MFInfo(), *factory);
+  for (amrex::MFIter mfi(S); mfi.isValid(); ++mfi) {
+    const amrex::Box gbox = mfi.fabbox();
+    const amrex::EBCellFlagFab& flagfab = flags[mfi];
+    if (flagfab.getType(gbox) != amrex::FabType::singlevalued) {
+      continue;
+    }
+
+    amrex::FArrayBox q(gbox, QVAR);
+    amrex::FArrayBox qaux(gbox, NQAUX);
+    amrex::FArrayBox coef(gbox, nCompTr);
+    fill_state(ctx.geom, S[mfi]);
+    fill_primitives(S[mfi], q, qaux);
+    fill_transport_coeffs(q, coef);
+
+    // Sorted cut cells and their geometry, as in initialize_eb2_structs
+    amrex::Vector<EBBndryGeom> h_ebg;
+    for (amrex::BoxIterator bit(gbox); bit.ok(); ++bit) {
+      const amrex::EBCellFlag& flag = flagfab(bit(), 0);
+      if (!(flag.isRegular() || flag.isCovered())) {
+        EBBndryGeom ebg_cell{};
+        ebg_cell.iv = bit();
+        h_ebg.push_back(ebg_cell);
+      }
+    }
+    std::sort(
+      h_ebg.begin(), h_ebg.end(),
+      [](const EBBndryGeom& a, const EBBndryGeom& b) { return a.iv < b.iv; });
+    const int Ncut = h_ebg.size();
+    amrex::Gpu::DeviceVector<EBBndryGeom> ebg(Ncut);
+    amrex::Gpu::copy(
+      amrex::Gpu::hostToDevice, h_ebg.begin(), h_ebg.end(), ebg.begin());
+    pc_fill_sv_ebg(
+      gbox, Ncut, vfrac.const_array(mfi), bndrycent.const_array(mfi),
+      AMREX_D_DECL(
+        areafrac[0]->const_array(mfi), areafrac[1]->const_array(mfi),
+        areafrac[2]->const_array(mfi)),
+      ebg.data());
+
+    amrex::Gpu::DeviceVector<EBBndrySten> sten(Ncut);
+    const amrex::Real dx = ctx.geom.CellSize(0);
+    run_benchmark(
+      ctx, "pc_fill_bndry_grad_stencil", Ncut,
+      static_cast<amrex::Real>(
+        Ncut * (sizeof(EBBndryGeom) + sizeof(EBBndrySten))),
+      [&]() {
+        pc_fill_bndry_grad_stencil(
+          gbox, dx, Ncut, ebg.data(), Ncut, sten.data());
+      });
+
+    // Isothermal wall heat flux and no-slip wall viscous flux
+    const amrex::Vector<amrex::Real> h_bcval(AMREX_SPACEDIM * Ncut, 300.0);
+    amrex::Gpu::DeviceVector<amrex::Real> bcval(AMREX_SPACEDIM * Ncut);
+    amrex::Gpu::DeviceVector<amrex::Real> bcflux(AMREX_SPACEDIM * Ncut);
+    amrex::Gpu::copy(
+      amrex::Gpu::hostToDevice, h_bcval.begin(), h_bcval.end(),
+      bcval.begin());
+    const auto qarr = q.const_array();
+    const auto coe_cc = coef.const_array();
+
+    run_benchmark(
+      ctx, "pc_apply_eb_boundry_flux_stencil", Ncut,
+      static_cast<amrex::Real>(
+        Ncut * (sizeof(EBBndrySten) + (2 * 27 + 2) * sizeof(amrex::Real))),
+      [&]() {
+        pc_apply_eb_boundry_flux_stencil(
+          ebfluxbox, sten.data(), Ncut, qarr, QTEMP, coe_cc, dComp_lambda,
+          bcval.data(), Ncut, bcflux.data(), Ncut, 1);
+      });
+
+    run_benchmark(
+      ctx, "pc_apply_eb_boundry_visc_flux_stencil", Ncut,
+      static_cast<amrex::Real>(
+        Ncut * (sizeof(EBBndrySten) + sizeof(EBBndryGeom) +
+                (AMREX_SPACEDIM * 29 + 2) * sizeof(amrex::Real))),
+      [&]() {
+        pc_apply_eb_boundry_visc_flux_stencil(
+          ebfluxbox, sten.data(), Ncut, ebg.data(), Ncut, qarr, coe_cc,
+          bcval.data(), Ncut, bcflux.data(), Ncut);
+      });
+
+    // Redistribution of a source term the size of the state
+    amrex::FArrayBox dUdt_in(cbox, NVAR);
+    amrex::FArrayBox dUdt_out(cbox, NVAR);
+    amrex::FArrayBox scratch(cbox, NVAR);
+    fill_state(ctx.geom, dUdt_in);
+    run_benchmark(
+      ctx, "Redistribution::Apply", bx.numPts(),
+      nbytes(cbox, 3 * NVAR) + nbytes(gbox, NVAR + 3 * AMREX_SPACEDIM + 2),
+      [&]() {
+        Redistribution::Apply(
+          bx, NVAR, dUdt_out.array(), dUdt_in.array(), S.const_array(mfi),
+          scratch.array(), flags.const_array(mfi),
+          AMREX_D_DECL(
+            areafrac[0]->const_array(mfi), areafrac[1]->const_array(mfi),
+            areafrac[2]->const_array(mfi)),
+          vfrac.const_array(mfi),
+          AMREX_D_DECL(
+            facecent[0]->const_array(mfi), facecent[1]->const_array(mfi),
+            facecent[2]->const_array(mfi)),
+          centroid.const_array(mfi), ctx.geom, ctx.dt,
+          ctx.redistribution_type);
+      });
+  }
+}
+
+} // namespace pelec_benchmarks
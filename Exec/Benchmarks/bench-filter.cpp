@@ -0,0 +1,33 @@
+/** \file bench-filter.cpp
+ *
+ *  Benchmark of the explicit LES filter, applied to the conserved state
+ */
+
+#include "Benchmark.H"
+#include "Filter.H"
+#include "IndexDefines.H"
+
+namespace pelec_benchmarks {
+
+void
+bench_filter(const BenchmarkContext& ctx)
+{
+  if (ctx.filter_type <= no_filter || ctx.filter_type >= num_filter_types) {
+    amrex::Abort("bench.filter_type must be a valid filter type");
+  }
+
+  const amrex::Box& bx = ctx.geom.Domain();
+  Filter filter(ctx.filter_type, ctx.filter_fgr);
+  const int ngrow = filter.get_filter_ngrow();
+
+  amrex::FArrayBox in(amrex::grow(bx, ngrow), NVAR);
+  amrex::FArrayBox out(bx, NVAR);
+  fill_state(ctx.geom, in);
+
+  run_benchmark(
+    ctx, "Filter::apply_filter", bx.numPts(),
+    nbytes(in.box(), NVAR) + nbytes(bx, NVAR),
+    [&]() { filter.apply_filter(bx, in, out); });
+}
+
+} // namespace pelec_benchmarks
@@ -0,0 +1,238 @@
+/** \file bench-hydro.cpp
+ *
+ *  Benchmarks of the hyperbolic kernels: the conversion to primitive
+ *  variables, the Riemann solver, the PLM and PPM reconstructions, the MOL
+ *  fluxes and the unsplit Godunov method
+ */
+
+#include "Benchmark.H"
+#include "Godunov.H"
+#include "MOL.H"
+#include "PLM.H"
+#include "PPM.H"
+#include "PeleC.H"
+#include "Utilities.H"
+
+namespace pelec_benchmarks {
+
+void
+bench_hydro(const BenchmarkContext& ctx)
+{
+  // The cells updated and the ghost cells of the state, as PeleC::numGrow()
+  const amrex::Box& bx = ctx.geom.Domain();
+  const int ng = 4;
+  const amrex::Box qbx = amrex::grow(bx, ng);
+  const amrex::Box bxg2 = amrex::grow(bx, 2);
+  const amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> dx =
+    ctx.geom.CellSizeArray();
+  const amrex::Real dt = ctx.dt;
+
+  amrex::FArrayBox S(qbx, NVAR);
+  amrex::FArrayBox q(qbx, QVAR);
+  amrex::FArrayBox qaux(qbx, NQAUX);
+  amrex::FArrayBox srcQ(qbx, QVAR);
+  fill_state(ctx.geom, S);
+  fill_primitives(S, q, qaux);
+  srcQ.setVal<amrex::RunOn::Device>(0.0);
+
+  const auto sarr = S.const_array();
+  const auto qarr = q.const_array();
+  const auto qauxar = qaux.const_array();
+  const auto srcqarr = srcQ.const_array();
+  PassMap const* lpmap = PeleC::d_pass_map;
+
+  {
+    amrex::FArrayBox qout(qbx, QVAR);
+    amrex::FArrayBox qauxout(qbx, NQAUX);
+    const auto qo = qout.array();
+    const auto qao = qauxout.array();
+    run_benchmark(
+      ctx, "pc_ctoprim", qbx.numPts(), nbytes(qbx, NVAR + QVAR + NQAUX),
+      [&]() {
+        amrex::ParallelFor(
+          qbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+            pc_ctoprim(i, j, k, sarr, qo, qao, *lpmap, 1);
+          });
+      });
+  }
+
+  // Riemann problems on the x faces, between the cell averages
+  {
+    const amrex::Box fbx = amrex::surroundingNodes(bx, 0);
+    amrex::FArrayBox flux(fbx, NVAR);
+    amrex::FArrayBox qgdnv(fbx, NGDNV);
+    const auto flx = flux.array();
+    const auto qint = qgdnv.array();
+    run_benchmark(
+      ctx, "riemann", fbx.numPts(),
+      nbytes(amrex::growLo(bx, 0, 1), QVAR + NQAUX) +
+        nbytes(fbx, NVAR + NGDNV),
+      [&]() {
+        amrex::ParallelFor(
+          fbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+            amrex::Real spl[NUM_SPECIES];
+            amrex::Real spr[NUM_SPECIES];
+            for (int n = 0; n < NUM_SPECIES; n++) {
+              spl[n] = qarr(i - 1, j, k, QFS + n);
+              spr[n] = qarr(i, j, k, QFS + n);
+            }
+            const amrex::Real cav =
+              0.5 * (qauxar(i, j, k, QC) + qauxar(i - 1, j, k, QC));
+            amrex::Real ustar = 0.0;
+            riemann(
+              qarr(i - 1, j, k, QRHO), qarr(i - 1, j, k, QU),
+              qarr(i - 1, j, k, QV), qarr(i - 1, j, k, QW),
+              qarr(i - 1, j, k, QPRES), qarr(i - 1, j, k, QREINT), spl,
+              qauxar(i - 1, j, k, QGAMC), qarr(i, j, k, QRHO),
+              qarr(i, j, k, QU), qarr(i, j, k, QV), qarr(i, j, k, QW),
+              qarr(i, j, k, QPRES), qarr(i, j, k, QREINT), spr,
+              qauxar(i, j, k, QGAMC), 1, qauxar(i, j, k, QCSML), cav, ustar,
+              flx(i, j, k, URHO), flx(i, j, k, UMX), flx(i, j, k, UMY),
+              flx(i, j, k, UMZ), flx(i, j, k, UEDEN), flx(i, j, k, UEINT),
+              qint(i, j, k, GDU), qint(i, j, k, GDV), qint(i, j, k, GDW),
+              qint(i, j, k, GDPRES), qint(i, j, k, GDGAME));
+          });
+      });
+  }
+
+  // Interface states in every direction, as in the first step of the
+  // unsplit Godunov method
+  {
+    amrex::FArrayBox qm[AMREX_SPACEDIM];
+    amrex::FArrayBox qp[AMREX_SPACEDIM];
+    amrex::Real bytes = nbytes(qbx, QVAR) + nbytes(bxg2, NQAUX);
+    for (int dir = 0; dir < AMREX_SPACEDIM; dir++) {
+      qm[dir].resize(amrex::growHi(bxg2, dir, 1), QVAR);
+      qp[dir].resize(bxg2, QVAR);
+      bytes += 2.0 * nbytes(bxg2, QVAR);
+    }
+    const auto qxm = qm[0].array();
+    const auto qxp = qp[0].array();
+#if AMREX_SPACEDIM > 1
+    const auto qym = qm[1].array();
+    const auto qyp = qp[1].array();
+#endif
+#if AMREX_SPACEDIM > 2
+    const auto qzm = qm[2].array();
+    const auto qzp = qp[2].array();
+#endif
+
+    run_benchmark(ctx, "trace_plm", bxg2.numPts(), bytes, [&]() {
+      amrex::ParallelFor(
+        bxg2, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+          amrex::Real slope[QVAR];
+          for (int n = 0; n < QVAR; ++n) {
+            slope[n] = plm_slope(i, j, k, n, 0, qarr);
+          }
+          pc_plm_x(
+            i, j, k, qxm, qxp, slope, qarr, qauxar(i, j, k, QC), dx[0], dt,
+            *lpmap);
+#if AMREX_SPACEDIM > 1
+          for (int n = 0; n < QVAR; ++n) {
+            slope[n] = plm_slope(i, j, k, n, 1, qarr);
+          }
+          pc_plm_y(
+            i, j, k, qym, qyp, slope, qarr, qauxar(i, j, k, QC), dx[1], dt,
+            *lpmap);
+#endif
+#if AMREX_SPACEDIM > 2
+          for (int n = 0; n < QVAR; ++n) {
+            slope[n] = plm_slope(i, j, k, n, 2, qarr);
+          }
+          pc_plm_z(
+            i, j, k, qzm, qzp, slope, qarr, qauxar(i, j, k, QC), dx[2], dt,
+            *lpmap);
+#endif
+        });
+    });
+
+    run_benchmark(ctx, "trace_ppm", bxg2.numPts(), bytes, [&]() {
+      for (int dir = 0; dir < AMREX_SPACEDIM; dir++) {
+        trace_ppm(
+          bxg2, dir, qarr, srcqarr, qm[dir].array(), qp[dir].array(), bxg2,
+          dt, dx.data(), 1, PeleC::use_hybrid_weno, PeleC::weno_scheme);
+      }
+    });
+  }
+
+  // Fluxes of the MOL source term, on the cells grown as in getMOLSrcTerm
+  {
+    const amrex::Box cbox = amrex::grow(bx, ng - 1);
+    amrex::GpuArray<amrex::FArrayBox, AMREX_SPACEDIM> area;
+    fill_areas(ctx.geom, cbox, area);
+    amrex::FArrayBox flux[AMREX_SPACEDIM];
+    amrex::Real bytes = nbytes(qbx, QVAR + NQAUX);
+    for (int dir = 0; dir < AMREX_SPACEDIM; dir++) {
+      flux[dir].resize(amrex::surroundingNodes(cbox, dir), NVAR);
+      flux[dir].setVal<amrex::RunOn::Device>(0.0);
+      bytes += nbytes(flux[dir].box(), NVAR + 1);
+    }
+    const amrex::GpuArray<amrex::Array4<amrex::Real>, AMREX_SPACEDIM> flx{
+      {AMREX_D_DECL(flux[0].array(), flux[1].array(), flux[2].array())}};
+    const amrex::GpuArray<
+      const amrex::Array4<const amrex::Real>, AMREX_SPACEDIM>
+      area_arr{{AMREX_D_DECL(
+        area[0].const_array(), area[1].const_array(), area[2].const_array())}};
+#ifdef PELEC_USE_EB
+    amrex::FArrayBox vfrac(qbx, 1);
+    amrex::EBCellFlagFab flags(qbx);
+    fill_regular_geometry(vfrac, flags);
+#endif
+
+    run_benchmark(
+      ctx, "pc_compute_hyp_mol_flux", cbox.numPts(), bytes, [&]() {
+        pc_compute_hyp_mol_flux(
+          cbox, qarr, qauxar, flx, area_arr, dx, 2
+#ifdef PELEC_USE_EB
+          ,
+          0.0, vfrac.const_array(), flags.const_array(), nullptr, 0, nullptr,
+          0
+#endif
+        );
+      });
+  }
+
+  // Unsplit Godunov fluxes with PPM, as in pc_umdrv
+#if AMREX_SPACEDIM > 1
+  {
+    amrex::GpuArray<amrex::FArrayBox, AMREX_SPACEDIM> area;
+    fill_areas(ctx.geom, qbx, area);
+    amrex::FArrayBox flux[AMREX_SPACEDIM];
+    amrex::FArrayBox qec[AMREX_SPACEDIM];
+    amrex::FArrayBox vol(qbx, 1);
+    amrex::FArrayBox pdivu(bx, 1);
+    vol.setVal<amrex::RunOn::Device>(AMREX_D_TERM(dx[0], *dx[1], *dx[2]));
+    amrex::Real bytes = nbytes(qbx, 2 * QVAR + NQAUX + 1) + nbytes(bx, 1);
+    for (int dir = 0; dir < AMREX_SPACEDIM; dir++) {
+      flux[dir].resize(amrex::surroundingNodes(bx, dir), NVAR);
+      qec[dir].resize(amrex::surroundingNodes(bxg2, dir), NGDNV);
+      bytes += nbytes(flux[dir].box(), NVAR + 1);
+    }
+    const int bclo[AMREX_SPACEDIM] = {0};
+    const int bchi[AMREX_SPACEDIM] = {0};
+    const int* domlo = ctx.geom.Domain().loVect();
+    const int* domhi = ctx.geom.Domain().hiVect();
+
+#if AMREX_SPACEDIM == 3
+    run_benchmark(ctx, "pc_umeth_3D", bx.numPts(), bytes, [&]() {
+      pc_umeth_3D(
+        bx, bclo, bchi, domlo, domhi, qarr, qauxar, srcqarr, flux[0].array(),
+        flux[1].array(), flux[2].array(), qec[0].array(), qec[1].array(),
+        qec[2].array(), area[0].const_array(), area[1].const_array(),
+        area[2].const_array(), pdivu.array(), vol.const_array(), dx.data(),
+        dt, 1, 1);
+    });
+#else
+    run_benchmark(ctx, "pc_umeth_2D", bx.numPts(), bytes, [&]() {
+      pc_umeth_2D(
+        bx, bclo, bchi, domlo, domhi, qarr, qauxar, srcqarr, flux[0].array(),
+        flux[1].array(), qec[0].array(), qec[1].array(),
+        area[0].const_array(), area[1].const_array(), pdivu.array(),
+        vol.const_array(), dx.data(), dt, 1, 1);
+    });
+#endif
+  }
+#endif
+}
+
+} // namespace pelec_benchmarks
@@ -0,0 +1,42 @@
+/** \file bench-reactions.cpp
+ *
+ *  Benchmark of the explicit (RK64) chemistry integrator
+ */
+
+#include "Benchmark.H"
+#include "PeleC.H"
+#include "React.H"
+
+namespace pelec_benchmarks {
+
+void
+bench_reactions(const BenchmarkContext& ctx)
+{
+  const amrex::Box& bx = ctx.geom.Domain();
+  amrex::FArrayBox S(bx, NVAR);
+  amrex::FArrayBox Snew(bx, NVAR);
+  amrex::FArrayBox nr_src(bx, NVAR);
+  amrex::FArrayBox react_src(bx, NUM_SPECIES + 2);
+  fill_state(ctx.geom, S);
+  nr_src.setVal<amrex::RunOn::Device>(0.0);
+
+  const auto sold = S.const_array();
+  const auto snew = Snew.array();
+  const auto nonrs = nr_src.const_array();
+  const auto I_R = react_src.array();
+  const amrex::Real dt = ctx.react_dt;
+
+  // The defaults of the adaptrk_* parameters. The state is not updated, so
+  // that every call integrates the same problem.
+  run_benchmark(
+    ctx, "pc_expl_reactions", bx.numPts(),
+    nbytes(bx, 2 * NVAR + NUM_SPECIES + 2), [&]() {
+      amrex::ParallelFor(
+        bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+          pc_expl_reactions(
+            i, j, k, sold, snew, nonrs, I_R, dt, 20, 300, 50, 1.0e-12, 0, 1);
+        });
+    });
+}
+
+} // namespace pelec_benchmarks
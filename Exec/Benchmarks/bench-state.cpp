@@ -0,0 +1,168 @@
+/** \file bench-state.cpp
+ *
+ *  Deterministic synthetic states for the kernel benchmarks, and the output
+ *  of their results
+ */
+
+#include <iomanip>
+#include <sstream>
+
+#include "Benchmark.H"
+#include "Constants.H"
+#include "IndexDefines.H"
+#include "PeleC.H"
+#include "TransportTable.H"
+#include "Utilities.H"
+
+namespace pelec_benchmarks {
+
+bool
+BenchmarkContext::selected(const std::string& name) const
+{
+  if (kernels.empty()) {
+    return true;
+  }
+  for (const auto& kernel : kernels) {
+    if (kernel == name) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Smooth periodic fields with all the species present, at temperatures and
+// velocities typical of a reacting flow: T in [300, 1500] K, p within 10% of
+// one atmosphere and velocities up to 100 m/s
+void
+fill_state(const amrex::Geometry& geom, amrex::FArrayBox& S)
+{
+  const amrex::Box& bx = S.box();
+  const auto s = S.array();
+  const auto prob_lo = geom.ProbLoArray();
+  const auto dx = geom.CellSizeArray();
+  S.setVal<amrex::RunOn::Device>(0.0);
+
+  amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+    const amrex::Real twopi = 2.0 * constants::PI();
+    const amrex::Real x = prob_lo[0] + (i + 0.5) * dx[0];
+    amrex::Real y = 0.0;
+    amrex::Real z = 0.0;
+#if AMREX_SPACEDIM > 1
+    y = prob_lo[1] + (j + 0.5) * dx[1];
+#endif
+#if AMREX_SPACEDIM > 2
+    z = prob_lo[2] + (k + 0.5) * dx[2];
+#endif
+
+    const amrex::Real T =
+      900.0 + 600.0 * std::sin(twopi * x) * std::cos(twopi * y);
+    const amrex::Real p =
+      1.01325e6 * (1.0 + 0.1 * std::cos(twopi * (x + z)));
+    amrex::Real massfrac[NUM_SPECIES];
+    amrex::Real sum = 0.0;
+    for (int n = 0; n < NUM_SPECIES; n++) {
+      const amrex::Real phase =
+        static_cast<amrex::Real>(n + 1) / (NUM_SPECIES + 1);
+      massfrac[n] = 1.0 + 0.9 * std::sin(twopi * (x + y + phase));
+      sum += massfrac[n];
+    }
+    for (int n = 0; n < NUM_SPECIES; n++) {
+      massfrac[n] /= sum;
+    }
+    const amrex::Real u = 1.0e4 * std::sin(twopi * y) * std::cos(twopi * z);
+    const amrex::Real v = 1.0e4 * std::sin(twopi * z) * std::cos(twopi * x);
+    const amrex::Real w = 1.0e4 * std::sin(twopi * x) * std::cos(twopi * y);
+
+    amrex::Real rho = 0.0, eint = 0.0;
+    auto eos = pele::physics::PhysicsType::eos();
+    eos.PYT2RE(p, massfrac, T, rho, eint);
+
+    s(i, j, k, URHO) = rho;
+    s(i, j, k, UMX) = rho * u;
+    s(i, j, k, UMY) = rho * v;
+    s(i, j, k, UMZ) = rho * w;
+    s(i, j, k, UEINT) = rho * eint;
+    s(i, j, k, UEDEN) = rho * (eint + 0.5 * (u * u + v * v + w * w));
+    s(i, j, k, UTEMP) = T;
+    for (int n = 0; n < NUM_SPECIES; n++) {
+      s(i, j, k, UFS + n) = rho * massfrac[n];
+    }
+  });
+}
+
+void
+fill_primitives(
+  const amrex::FArrayBox& S, amrex::FArrayBox& q, amrex::FArrayBox& qaux)
+{
+  const auto s = S.const_array();
+  const auto qarr = q.array();
+  const auto qauxar = qaux.array();
+  PassMap const* lpmap = PeleC::d_pass_map;
+  amrex::ParallelFor(
+    q.box(), [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+      pc_ctoprim(i, j, k, s, qarr, qauxar, *lpmap, 1);
+    });
+}
+
+void
+fill_transport_coeffs(const amrex::FArrayBox& q, amrex::FArrayBox& coef)
+{
+  pc_get_transport_coeffs(
+    coef.box(), q.const_array(QFS), q.const_array(QTEMP),
+    q.const_array(QRHO), coef.array(dComp_rhoD), coef.array(dComp_mu),
+    coef.array(dComp_xi), coef.array(dComp_lambda),
+    pele::physics::transport::trans_parm_g, TransportTable());
+}
+
+void
+fill_areas(
+  const amrex::Geometry& geom,
+  const amrex::Box& bx,
+  amrex::GpuArray<amrex::FArrayBox, AMREX_SPACEDIM>& area)
+{
+  for (int dir = 0; dir < AMREX_SPACEDIM; dir++) {
+    amrex::Real a = 1.0;
+    for (int d = 0; d < AMREX_SPACEDIM; d++) {
+      if (d != dir) {
+        a *= geom.CellSize(d);
+      }
+    }
+    area[dir].resize(amrex::surroundingNodes(bx, dir), 1);
+    area[dir].setVal<amrex::RunOn::Device>(a);
+  }
+}
+
+#ifdef PELEC_USE_EB
+void
+fill_regular_geometry(amrex::FArrayBox& vfrac, amrex::EBCellFlagFab& flags)
+{
+  vfrac.setVal<amrex::RunOn::Device>(1.0);
+  flags.setVal<amrex::RunOn::Device>(amrex::EBCellFlag::TheDefaultCell());
+}
+#endif
+
+void
+report(
+  const BenchmarkContext& ctx,
+  const std::string& name,
+  const amrex::Long cells,
+  const amrex::Real bytes_per_cell,
+  const amrex::Real time_min,
+  const amrex::Real time_avg)
+{
+  if (!amrex::ParallelDescriptor::IOProcessor()) {
+    return;
+  }
+
+  std::ostringstream rec;
+  rec << std::setprecision(8);
+  rec << "{\"benchmark\": \"" << name << "\", \"dim\": " << AMREX_SPACEDIM
+      << ", \"ncell\": " << ctx.ncell << ", \"nspec\": " << NUM_SPECIES
+      << ", \"cells\": " << cells << ", \"nrep\": " << ctx.nrep
+      << ", \"time_min\": " << time_min << ", \"time_avg\": " << time_avg
+      << ", \"cells_per_s\": " << cells / time_min
+      << ", \"bytes_per_cell\": " << bytes_per_cell << "}\n";
+  *ctx.out << rec.str() << std::flush;
+}
+
+} // namespace pelec_benchmarks
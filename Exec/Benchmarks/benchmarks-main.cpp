@@ -0,0 +1,111 @@
+/** \file benchmarks-main.cpp
+ *  Entry point for the kernel benchmarks
+ *
+ *  Runs the benchmarks selected with bench.kernels (all of them by default)
+ *  and writes one JSON record per benchmark to bench.output, or to the
+ *  standard output when it is not given. For example:
+ *
+ *    PeleC-Benchmarks bench.ncell=64 bench.nrep=20 bench.output=bench.json
+ */
+
+#include <fstream>
+#include <iostream>
+
+#include "AMReX.H"
+#include "AMReX_ParmParse.H"
+#include "Benchmark.H"
+#include "PeleC.H"
+
+// Necessary as it's used in other source files
+std::string inputs_name;
+
+namespace {
+
+// The parts of the PeleC setup the kernels rely on
+void
+init_physics()
+{
+  PeleC::h_pass_map = new PassMap{};
+  PeleC::d_pass_map =
+    static_cast<PassMap*>(amrex::The_Arena()->alloc(sizeof(PassMap)));
+  init_pass_map(PeleC::h_pass_map);
+  amrex::Gpu::copy(
+    amrex::Gpu::hostToDevice, PeleC::h_pass_map, PeleC::h_pass_map + 1,
+    PeleC::d_pass_map);
+
+  pele::physics::transport::InitTransport<
+    pele::physics::PhysicsType::eos_type>()();
+}
+
+void
+close_physics()
+{
+  pele::physics::transport::CloseTransport<
+    pele::physics::PhysicsType::eos_type>()();
+
+  amrex::The_Arena()->free(PeleC::d_pass_map);
+  delete PeleC::h_pass_map;
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+  amrex::Initialize(argc, argv);
+  {
+    pelec_benchmarks::BenchmarkContext ctx;
+    std::string output;
+    {
+      amrex::ParmParse pp("bench");
+      pp.query("ncell", ctx.ncell);
+      pp.query("nrep", ctx.nrep);
+      pp.query("dt", ctx.dt);
+      pp.query("react_dt", ctx.react_dt);
+      pp.query("filter_type", ctx.filter_type);
+      pp.query("filter_fgr", ctx.filter_fgr);
+      pp.query("redistribution_type", ctx.redistribution_type);
+      pp.queryarr("kernels", ctx.kernels);
+      pp.query("output", output);
+    }
+    if (ctx.ncell < 8 || ctx.nrep < 1) {
+      amrex::Abort("bench.ncell must be at least 8 and bench.nrep positive");
+    }
+
+    const amrex::Box domain(
+      amrex::IntVect(AMREX_D_DECL(0, 0, 0)),
+      amrex::IntVect(
+        AMREX_D_DECL(ctx.ncell - 1, ctx.ncell - 1, ctx.ncell - 1)));
+    const amrex::RealBox real_box(
+      {AMREX_D_DECL(0.0, 0.0, 0.0)}, {AMREX_D_DECL(1.0, 1.0, 1.0)});
+    const int is_periodic[AMREX_SPACEDIM] = {AMREX_D_DECL(1, 1, 1)};
+    ctx.geom.define(domain, &real_box, 0, is_periodic);
+
+    std::ofstream ofs;
+    ctx.out = &std::cout;
+    if (!output.empty() && amrex::ParallelDescriptor::IOProcessor()) {
+      ofs.open(output, std::ios::app);
+      if (!ofs.good()) {
+        amrex::Abort("Unable to open bench.output " + output);
+      }
+      ctx.out = &ofs;
+    }
+
+    init_physics();
+
+    pelec_benchmarks::bench_hydro(ctx);
+    pelec_benchmarks::bench_diffusion(ctx);
+#ifdef PELEC_USE_REACTIONS
+    pelec_benchmarks::bench_reactions(ctx);
+#endif
+    pelec_benchmarks::bench_filter(ctx);
+#ifdef PELEC_USE_EB
+    pelec_benchmarks::bench_eb(ctx);
+#endif
+
+    close_physics();
+  }
+  amrex::Finalize();
+
+  return 0;
+}
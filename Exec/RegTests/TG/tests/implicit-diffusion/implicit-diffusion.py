@@ -0,0 +1,53 @@
+# ========================================================================
+#
+# Imports
+#
+# ========================================================================
+import os
+import numpy as np
+import pandas as pd
+import unittest
+
+
+# ========================================================================
+#
+# Test definitions
+#
+# ========================================================================
+class ImplicitDiffusionTestCase(unittest.TestCase):
+    """Tests for the implicit diffusion in Pele."""
+
+    def final_value(self, run, column):
+        """Value of a datlog column at the final time of a run."""
+        fdir = os.path.abspath(".")
+        fname = os.path.join(fdir, run, "datlog")
+        df = pd.read_csv(fname, delim_whitespace=True)
+        return df[column].iloc[-1], df["time"].iloc[-1]
+
+    def test_convergence(self):
+        """Does the implicit diffusion converge to the explicit solution?"""
+
+        # run0 is the explicit reference, run1 and run2 the implicit
+        # runs with dt and dt/2
+        ref, tref = self.final_value("run0", "rho_K")
+        coarse, tcoarse = self.final_value("run1", "rho_K")
+        fine, tfine = self.final_value("run2", "rho_K")
+        np.testing.assert_allclose([tcoarse, tfine], tref, rtol=1e-10)
+
+        err_coarse = abs(coarse - ref) / ref
+        err_fine = abs(fine - ref) / ref
+        self.assertLess(err_coarse, 0.2)
+        self.assertLess(err_fine, err_coarse)
+
+        # The implicit Euler step and the splitting are first order
+        order = np.log2(err_coarse / err_fine)
+        self.assertGreater(order, 0.7)
+
+
+# ========================================================================
+#
+# Main
+#
+# ========================================================================
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,56 @@
+# ========================================================================
+#
+# Imports
+#
+# ========================================================================
+import os
+import numpy.testing as npt
+import pandas as pd
+import unittest
+
+
+# ========================================================================
+#
+# Test definitions
+#
+# ========================================================================
+class LightCheckpointTestCase(unittest.TestCase):
+    """Tests for the rollback to the lightweight checkpoints in Pele."""
+
+    def test_rollback(self):
+        """Does the rolled back run repeat the steps after the checkpoint?"""
+
+        fdir = os.path.abspath(".")
+
+        # run0 rolled back from step 5 to the lightweight checkpoint of
+        # step 3 and wrote it as chk00003
+        fname = os.path.join(fdir, "run0", "light-ckpt-rollback-run0.log")
+        with open(fname) as f:
+            log = f.read()
+        self.assertIn("Rolled back to the lightweight checkpoint at step 3", log)
+        self.assertTrue(os.path.isdir(os.path.join(fdir, "run0", "chk00003")))
+
+        # run1 restarted from chk00003 and took step 4 again. With the same
+        # state, step count and dt, it matches the first step 4 of run0.
+        ref = pd.read_csv(os.path.join(fdir, "run0", "datlog"), delim_whitespace=True)
+        # The header is only written at time 0, so the restart has none
+        rst = pd.read_csv(
+            os.path.join(fdir, "run1", "datlog"),
+            delim_whitespace=True,
+            header=None,
+            names=ref.columns,
+        )
+        self.assertEqual(len(ref), 6)
+        step4 = ref.iloc[4]
+        last = rst.iloc[-1]
+        for col in ref.columns:
+            npt.assert_allclose(last[col], step4[col], rtol=1e-12, atol=0.0)
+
+
+# ========================================================================
+#
+# Main
+#
+# ========================================================================
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,170 @@
+/** \file test-filter.cpp
+ *
+ *  Tests the explicit LES filters against the direct tensor-product stencil
+ *  and reports the time taken by both
+ */
+
+#include "gtest/gtest.h"
+#include "AMReX_FArrayBox.H"
+#include "AMReX_Gpu.H"
+#include "AMReX_ParallelDescriptor.H"
+#include "AMReX_Print.H"
+#include "Filter.H"
+
+namespace pelec_tests {
+
+namespace {
+
+// Direct application of the (2*ngrow+1)^dim stencil
+void
+tensor_product_filter(
+  const amrex::Box& bx,
+  const amrex::Vector<amrex::Real>& weights,
+  const amrex::FArrayBox& in,
+  amrex::FArrayBox& out)
+{
+  const int ngrow = (static_cast<int>(weights.size()) - 1) / 2;
+  amrex::Gpu::DeviceVector<amrex::Real> d_weights(weights.size());
+  amrex::Gpu::copy(
+    amrex::Gpu::hostToDevice, weights.begin(), weights.end(),
+    d_weights.begin());
+  const amrex::Real* w = d_weights.data();
+
+  const auto q = in.const_array();
+  const auto qh = out.array();
+  const amrex::Box stencil(amrex::IntVect(-ngrow), amrex::IntVect(ngrow));
+  amrex::ParallelFor(
+    bx, in.nComp(), [=] AMREX_GPU_DEVICE(int i, int j, int k, int n) noexcept {
+      amrex::Real sum = 0.0;
+      const auto slo = amrex::lbound(stencil);
+      const auto shi = amrex::ubound(stencil);
+      for (int p = slo.z; p <= shi.z; p++) {
+        for (int m = slo.y; m <= shi.y; m++) {
+          for (int l = slo.x; l <= shi.x; l++) {
+            const amrex::Real wt = AMREX_D_TERM(
+              w[l + ngrow], *w[m + ngrow], *w[p + ngrow]);
+            sum += wt * q(i + l, j + m, k + p, n);
+          }
+        }
+      }
+      qh(i, j, k, n) = sum;
+    });
+  amrex::Gpu::streamSynchronize();
+}
+
+void
+fill_field(amrex::FArrayBox& fab)
+{
+  const auto a = fab.array();
+  const amrex::Box& bx = fab.box();
+  for (int n = 0; n < fab.nComp(); n++) {
+    amrex::LoopOnCpu(bx, [=](int i, int j, int k) {
+      a(i, j, k, n) = std::sin(0.3 * i + 0.7 * j) * std::cos(0.5 * k) +
+                      0.1 * ((i * 7 + j * 13 + k * 17 + n * 5) % 11) + n;
+    });
+  }
+}
+
+amrex::Real
+max_difference(
+  const amrex::Box& bx, const amrex::FArrayBox& a, const amrex::FArrayBox& b)
+{
+  const auto aa = a.const_array();
+  const auto ba = b.const_array();
+  amrex::Real diff = 0.0;
+  for (int n = 0; n < a.nComp(); n++) {
+    amrex::LoopOnCpu(bx, [&](int i, int j, int k) {
+      diff = amrex::max(diff, std::abs(aa(i, j, k, n) - ba(i, j, k, n)));
+    });
+  }
+  return diff;
+}
+
+} // namespace
+
+// cppcheck-suppress missingOverride
+TEST(Filter, SeparableMatchesTensorProduct)
+{
+  const amrex::Box bx(amrex::IntVect(0), amrex::IntVect(31));
+  const int ncomp = 5;
+  const int nrep = 5;
+  const int fgrs[] = {2, 4, 6, 8};
+
+  for (int type = box; type < num_filter_types; type++) {
+    for (const int fgr : fgrs) {
+      Filter filter(type, fgr);
+      const int ngrow = filter.get_filter_ngrow();
+
+      amrex::FArrayBox in(
+        amrex::grow(bx, ngrow), ncomp, amrex::The_Pinned_Arena());
+      amrex::FArrayBox out(bx, ncomp, amrex::The_Pinned_Arena());
+      amrex::FArrayBox ref(bx, ncomp, amrex::The_Pinned_Arena());
+      fill_field(in);
+
+      amrex::Real strt_time = amrex::ParallelDescriptor::second();
+      for (int rep = 0; rep < nrep; rep++) {
+        tensor_product_filter(bx, filter.get_filter_weights(), in, ref);
+      }
+      const amrex::Real ref_time =
+        (amrex::ParallelDescriptor::second() - strt_time) / nrep;
+
+      strt_time = amrex::ParallelDescriptor::second();
+      for (int rep = 0; rep < nrep; rep++) {
+        filter.apply_filter(bx, in, out);
+        amrex::Gpu::streamSynchronize();
+      }
+      const amrex::Real sep_time =
+        (amrex::ParallelDescriptor::second() - strt_time) / nrep;
+
+      EXPECT_NEAR(max_difference(bx, out, ref), 0.0, 1.0e-12)
+        << "filter type " << type << ", fgr " << fgr;
+
+      amrex::Print() << "Filter type " << type << ", fgr " << fgr
+                     << ", ngrow " << ngrow
+                     << ": tensor product = " << ref_time
+                     << " s, separable = " << sep_time << " s" << std::endl;
+    }
+  }
+}
+
+// cppcheck-suppress missingOverride
+TEST(Filter, FusedFieldsMatchSingleFields)
+{
+  const amrex::Box bx(amrex::IntVect(0), amrex::IntVect(15));
+  const int ncomps[] = {6, 3, 9, 1, 3, 2, 4, 1, 5, 2};
+  const int nfields = sizeof(ncomps) / sizeof(ncomps[0]);
+
+  Filter filter(gaussian, 4);
+  const int ngrow = filter.get_filter_ngrow();
+
+  amrex::Vector<std::unique_ptr<amrex::FArrayBox>> in(nfields);
+  amrex::Vector<std::unique_ptr<amrex::FArrayBox>> fused(nfields);
+  amrex::Vector<std::unique_ptr<amrex::FArrayBox>> single(nfields);
+  amrex::Vector<const amrex::FArrayBox*> in_ptrs(nfields);
+  amrex::Vector<amrex::FArrayBox*> fused_ptrs(nfields);
+  for (int f = 0; f < nfields; f++) {
+    in[f] = std::make_unique<amrex::FArrayBox>(
+      amrex::grow(bx, ngrow), ncomps[f], amrex::The_Pinned_Arena());
+    fused[f] = std::make_unique<amrex::FArrayBox>(
+      bx, ncomps[f], amrex::The_Pinned_Arena());
+    single[f] = std::make_unique<amrex::FArrayBox>(
+      bx, ncomps[f], amrex::The_Pinned_Arena());
+    fill_field(*in[f]);
+    in_ptrs[f] = in[f].get();
+    fused_ptrs[f] = fused[f].get();
+  }
+
+  // More fields than are fused in one launch
+  filter.apply_filter(bx, in_ptrs, fused_ptrs);
+  for (int f = 0; f < nfields; f++) {
+    filter.apply_filter(bx, *in[f], *single[f]);
+  }
+  amrex::Gpu::streamSynchronize();
+
+  for (int f = 0; f < nfields; f++) {
+    EXPECT_NEAR(max_difference(bx, *fused[f], *single[f]), 0.0, 1.0e-14)
+      << "field " << f;
+  }
+}
+
+} // namespace pelec_tests
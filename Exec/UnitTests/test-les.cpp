@@ -0,0 +1,66 @@
+/** \file test-les.cpp
+ *
+ *  Tests the properties of the algebraic LES eddy viscosity models
+ */
+
+#include "gtest/gtest.h"
+#include "LES.H"
+
+namespace pelec_tests {
+
+namespace {
+
+#if AMREX_SPACEDIM == 3
+amrex::Real
+model_operator(const amrex::Real g[3][3], const int model)
+{
+  amrex::Real S[3][3] = {{0.0}};
+  amrex::Real Sijmag = 0.0;
+  for (int m = 0; m < 3; m++) {
+    for (int n = 0; n < 3; n++) {
+      S[m][n] = 0.5 * (g[m][n] + g[n][m]);
+      Sijmag += S[m][n] * S[m][n];
+    }
+  }
+  Sijmag = std::sqrt(2.0 * Sijmag);
+  return pc_sgs_model_operator(g, S, Sijmag, model);
+}
+#endif
+
+} // namespace
+
+// cppcheck-suppress missingOverride
+TEST(LES, AlgebraicModelsVanishInPureShear)
+{
+#if AMREX_SPACEDIM == 3
+  const amrex::Real g[3][3] = {{0.0, 2.0, 0.0}, {0.0, 0.0, 0.0}, {0.0}};
+  EXPECT_NEAR(model_operator(g, 0), 2.0, 1.0e-12);
+  for (int model = 2; model <= 4; model++) {
+    EXPECT_NEAR(model_operator(g, model), 0.0, 1.0e-12) << "model " << model;
+  }
+#else
+  GTEST_SKIP();
+#endif
+}
+
+// cppcheck-suppress missingOverride
+TEST(LES, SigmaSingularValues)
+{
+#if AMREX_SPACEDIM == 3
+  // Singular values (3, 2, 1): D = s3 (s1 - s2) (s2 - s3) / s1^2
+  const amrex::Real g[3][3] = {
+    {3.0, 0.0, 0.0}, {0.0, 2.0, 0.0}, {0.0, 0.0, 1.0}};
+  EXPECT_NEAR(model_operator(g, 4), 1.0 / 9.0, 1.0e-10);
+
+  // Isotropic expansion and solid body rotation
+  const amrex::Real ge[3][3] = {
+    {1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}, {0.0, 0.0, 1.0}};
+  const amrex::Real gr[3][3] = {{0.0, -1.0, 0.0}, {1.0, 0.0, 0.0}, {0.0}};
+  EXPECT_NEAR(model_operator(ge, 4), 0.0, 1.0e-12);
+  EXPECT_NEAR(model_operator(gr, 4), 0.0, 1.0e-12);
+#else
+  GTEST_SKIP();
+#endif
+}
+
+} // namespace pelec_tests
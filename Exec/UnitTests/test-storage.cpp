@@ -0,0 +1,77 @@
+/** \file test-storage.cpp
+ *
+ *  Tests the single-precision storage of the scalars in the lightweight
+ *  checkpoints
+ */
+
+#include <cmath>
+#include <limits>
+
+#include "gtest/gtest.h"
+#include "AMReX_FArrayBox.H"
+#include "AMReX_Arena.H"
+#include "Utilities.H"
+
+namespace pelec_tests {
+
+// cppcheck-suppress missingOverride
+TEST(Storage, FloatScalarsRoundTrip)
+{
+  const amrex::Box bx(amrex::IntVect(0), amrex::IntVect(7));
+  amrex::FArrayBox state(bx, NVAR, amrex::The_Pinned_Arena());
+  amrex::FArrayBox restored(bx, NVAR, amrex::The_Pinned_Arena());
+  amrex::BaseFab<float> scalars(bx, NVAR - UFA, amrex::The_Pinned_Arena());
+  const auto s = state.array();
+  const auto r = restored.array();
+  const auto f = scalars.array();
+
+  amrex::LoopOnCpu(bx, [=](int i, int j, int k) noexcept {
+    const amrex::Real rho = 1.0e-3 * (1.0 + 0.1 * i + 0.01 * j + 0.001 * k);
+    s(i, j, k, URHO) = rho;
+    for (int n = 1; n < UFA; n++) {
+      s(i, j, k, n) = n * rho;
+    }
+    for (int n = UFA; n < NVAR; n++) {
+      s(i, j, k, n) = 0.0;
+    }
+    // Species fractions spanning several decades
+    amrex::Real sumY = 0.0;
+    for (int n = 0; n < NUM_SPECIES; n++) {
+      const amrex::Real Y = std::pow(10.0, -(n % 6)) * (1.0 + 0.3 * i);
+      s(i, j, k, UFS + n) = Y;
+      sumY += Y;
+    }
+    for (int n = 0; n < NUM_SPECIES; n++) {
+      s(i, j, k, UFS + n) *= rho / sumY;
+    }
+  });
+
+  amrex::LoopOnCpu(bx, [=](int i, int j, int k) noexcept {
+    pc_store_float_scalars(i, j, k, s, f);
+    for (int n = 0; n < UFA; n++) {
+      r(i, j, k, n) = s(i, j, k, n);
+    }
+    pc_load_float_scalars(i, j, k, f, r);
+  });
+
+  // Each scalar comes back to within a few float ulps, and the species still
+  // sum to the density to double-precision round-off
+  const amrex::Real float_eps = std::numeric_limits<float>::epsilon();
+  amrex::LoopOnCpu(bx, [=](int i, int j, int k) noexcept {
+    for (int n = 0; n < UFA; n++) {
+      EXPECT_EQ(r(i, j, k, n), s(i, j, k, n));
+    }
+    amrex::Real rhoY = 0.0;
+    for (int n = UFA; n < NVAR; n++) {
+      EXPECT_NEAR(
+        r(i, j, k, n), s(i, j, k, n),
+        2.0 * float_eps * std::abs(s(i, j, k, n)));
+    }
+    for (int n = 0; n < NUM_SPECIES; n++) {
+      rhoY += r(i, j, k, UFS + n);
+    }
+    EXPECT_NEAR(rhoY, r(i, j, k, URHO), 1.0e-14 * r(i, j, k, URHO));
+  });
+}
+
+} // namespace pelec_tests
@@ -0,0 +1,37 @@
+/** \file test-timestep.cpp
+ *
+ *  Tests the PI controller of the error-controlled MOL timestep
+ */
+
+#include "gtest/gtest.h"
+#include "Timestep.H"
+
+namespace pelec_tests {
+
+// cppcheck-suppress missingOverride
+TEST(Timestep, PIFactorKeepsDtAtTolerance)
+{
+  EXPECT_NEAR(pc_pi_dt_factor(1.0, 0.0, 0.9), 0.9, 1.0e-12);
+  EXPECT_NEAR(pc_pi_dt_factor(1.0, 1.0, 0.9), 0.9, 1.0e-12);
+}
+
+// cppcheck-suppress missingOverride
+TEST(Timestep, PIFactorFollowsTheError)
+{
+  // Without history, the error is reduced as dt^2
+  EXPECT_NEAR(pc_pi_dt_factor(0.25, 0.0, 1.0), 2.0, 1.0e-12);
+  EXPECT_NEAR(pc_pi_dt_factor(4.0, 0.0, 1.0), 0.5, 1.0e-12);
+
+  // A growing error shortens the step more than a steady one
+  EXPECT_LT(pc_pi_dt_factor(2.0, 1.0, 1.0), pc_pi_dt_factor(2.0, 2.0, 1.0));
+  EXPECT_GT(pc_pi_dt_factor(0.5, 1.0, 1.0), pc_pi_dt_factor(0.5, 0.5, 1.0));
+}
+
+// cppcheck-suppress missingOverride
+TEST(Timestep, PIFactorIsBounded)
+{
+  EXPECT_NEAR(pc_pi_dt_factor(0.0, 0.0, 0.9), 5.0, 1.0e-12);
+  EXPECT_NEAR(pc_pi_dt_factor(1.0e6, 1.0, 0.9), 0.2, 1.0e-12);
+}
+
+} // namespace pelec_tests
@@ -1,7 +1,11 @@
+#include <limits>
+#include <sstream>
+
 #include "mechanism.h"
 
 #include "PeleC.H"
 #include "IndexDefines.H"
+#include "Utilities.H"
 
 amrex::Real
 PeleC::advance(
@@ -20,6 +24,16 @@ PeleC::advance(
 
   int finest_level = parent->finestLevel();
 
+  if (telemetry_active()) {
+    if (telemetry_step_start < 0.0) {
+      telemetry_step_start = amrex::ParallelDescriptor::second();
+    }
+    if (telemetry_cells.size() <= level) {
+      telemetry_cells.resize(level + 1, 0.0);
+    }
+    telemetry_cells[level] += grids.d_numPts();
+  }
+
   if (level < finest_level && do_reflux) {
     getFluxReg(level + 1).reset();
 
@@ -29,6 +43,31 @@ PeleC::advance(
     }
   }
 
+  // Save the data that the advance updates in place, so that a failed step
+  // can be retried
+  amrex::MultiFab fine_flux_save;
+  amrex::MultiFab react_save;
+  if (use_retry) {
+    if (level > 0 && do_reflux) {
+      const amrex::MultiFab& fine_data = getFluxReg().getFineData();
+      fine_flux_save.define(
+        fine_data.boxArray(), fine_data.DistributionMap(), fine_data.nComp(),
+        fine_data.nGrowVect());
+      amrex::MultiFab::Copy(
+        fine_flux_save, fine_data, 0, 0, fine_data.nComp(),
+        fine_data.nGrowVect());
+    }
+#ifdef PELEC_USE_REACTIONS
+    if (do_mol && do_react) {
+      const amrex::MultiFab& I_R = get_new_data(Reactions_Type);
+      react_save.define(
+        grids, dmap, I_R.nComp(), I_R.nGrow(), amrex::MFInfo(), Factory());
+      amrex::MultiFab::Copy(
+        react_save, I_R, 0, 0, I_R.nComp(), I_R.nGrow());
+    }
+#endif
+  }
+
   amrex::Real dt_new;
   if (do_mol) {
     dt_new = do_mol_advance(time, dt, amr_iteration, amr_ncycle);
@@ -36,15 +75,297 @@ PeleC::advance(
     dt_new = do_sdc_advance(time, dt, amr_iteration, amr_ncycle);
   }
 
+  if (use_retry) {
+    retry_advance(
+      time, dt, amr_iteration, amr_ncycle, fine_flux_save, react_save);
+  }
+
+  report_box_costs();
+
   return dt_new;
 }
 
+amrex::Real
+PeleC::state_change(const amrex::MultiFab& S_a, const amrex::MultiFab& S_b)
+{
+  BL_PROFILE("PeleC::state_change()");
+
+  // Differences of the density and species densities relative to the
+  // density, and of the total energy relative to itself
+  const amrex::Real small = std::numeric_limits<amrex::Real>::min();
+  amrex::Real max_change = amrex::ReduceMax(
+    S_a, S_b, 0,
+    [=] AMREX_GPU_HOST_DEVICE(
+      amrex::Box const& bx, const amrex::Array4<const amrex::Real>& sa,
+      const amrex::Array4<const amrex::Real>& sb) noexcept -> amrex::Real {
+      amrex::Real change = 0.0;
+      amrex::Loop(bx, [&](int i, int j, int k) noexcept {
+        const amrex::Real rho_inv =
+          1.0 / amrex::max<amrex::Real>(sa(i, j, k, URHO), small);
+        const amrex::Real drho =
+          amrex::Math::abs(sa(i, j, k, URHO) - sb(i, j, k, URHO)) * rho_inv;
+        const amrex::Real rhoE = amrex::Math::abs(sa(i, j, k, UEDEN));
+        const amrex::Real dE =
+          amrex::Math::abs(sa(i, j, k, UEDEN) - sb(i, j, k, UEDEN)) /
+          amrex::max<amrex::Real>(rhoE, small);
+        change = amrex::max<amrex::Real>(change, amrex::max(drho, dE));
+        for (int n = 0; n < NUM_SPECIES; n++) {
+          change = amrex::max<amrex::Real>(
+            change,
+            amrex::Math::abs(sa(i, j, k, UFS + n) - sb(i, j, k, UFS + n)) *
+              rho_inv);
+        }
+      });
+      return change;
+    });
+  amrex::ParallelDescriptor::ReduceRealMax(max_change);
+  return max_change;
+}
+
+void
+PeleC::save_flux_registers()
+{
+  if (!do_reflux) {
+    return;
+  }
+
+  if (level < parent->finestLevel()) {
+    const amrex::MultiFab& crse = getFluxReg(level + 1).getCrseData();
+    if (
+      flux_reg_crse_save.boxArray() != crse.boxArray() ||
+      flux_reg_crse_save.DistributionMap() != crse.DistributionMap()) {
+      flux_reg_crse_save.define(
+        crse.boxArray(), crse.DistributionMap(), crse.nComp(), crse.nGrow());
+    }
+    amrex::MultiFab::Copy(
+      flux_reg_crse_save, crse, 0, 0, crse.nComp(), crse.nGrow());
+  }
+  if (level > 0) {
+    const amrex::MultiFab& fine = getFluxReg().getFineData();
+    if (
+      flux_reg_fine_save.boxArray() != fine.boxArray() ||
+      flux_reg_fine_save.DistributionMap() != fine.DistributionMap()) {
+      flux_reg_fine_save.define(
+        fine.boxArray(), fine.DistributionMap(), fine.nComp(), fine.nGrow());
+    }
+    amrex::MultiFab::Copy(
+      flux_reg_fine_save, fine, 0, 0, fine.nComp(), fine.nGrow());
+  }
+}
+
+void
+PeleC::restore_flux_registers()
+{
+  if (!do_reflux) {
+    return;
+  }
+
+  if (level < parent->finestLevel()) {
+    amrex::MultiFab& crse = getFluxReg(level + 1).getCrseData();
+    AMREX_ALWAYS_ASSERT(
+      flux_reg_crse_save.boxArray() == crse.boxArray() &&
+      flux_reg_crse_save.DistributionMap() == crse.DistributionMap());
+    amrex::MultiFab::Copy(
+      crse, flux_reg_crse_save, 0, 0, crse.nComp(), crse.nGrow());
+  }
+  if (level > 0) {
+    amrex::MultiFab& fine = getFluxReg().getFineData();
+    AMREX_ALWAYS_ASSERT(
+      flux_reg_fine_save.boxArray() == fine.boxArray() &&
+      flux_reg_fine_save.DistributionMap() == fine.DistributionMap());
+    amrex::MultiFab::Copy(
+      fine, flux_reg_fine_save, 0, 0, fine.nComp(), fine.nGrow());
+  }
+}
+
+bool
+PeleC::step_failed(
+  const amrex::MultiFab& S, std::string& cause, amrex::IntVect& where) const
+{
+  BL_PROFILE("PeleC::step_failed()");
+
+  if (S.contains_nan(0, NVAR, 0)) {
+    cause = "NaN in state";
+    bool found = false;
+    for (amrex::MFIter mfi(S); mfi.isValid(); ++mfi) {
+      if (S[mfi].contains_nan<amrex::RunOn::Device>(
+            mfi.validbox(), 0, NVAR, where)) {
+        found = true;
+        break;
+      }
+    }
+    pc_reduce_found_cell(found, where);
+    return true;
+  }
+
+  // The chemistry integrator can fail and still leave a finite state
+  if (react_failures > 0) {
+    cause = "chemistry integration failed in " +
+            std::to_string(react_failures) + " cells";
+    where = react_failure_cell;
+    return true;
+  }
+
+  if (S.min(URHO) < small_dens) {
+    cause = "density below small_dens";
+    where = S.minIndex(URHO);
+    return true;
+  }
+
+  if (S.min(UTEMP) <= 0.0) {
+    cause = "non-positive temperature";
+    where = S.minIndex(UTEMP);
+    return true;
+  }
+
+  return false;
+}
+
+void
+PeleC::retry_advance(
+  amrex::Real time,
+  amrex::Real dt,
+  int amr_iteration,
+  int amr_ncycle,
+  const amrex::MultiFab& fine_flux_save,
+  const amrex::MultiFab& react_save)
+{
+  // If the step produced an invalid state, restore the state at the start of
+  // the step and advance it again in subcycles, with the number of subcycles
+  // growing by retry_subcycle_factor until the step succeeds. The old time
+  // level is reset afterwards so that finer levels and the next step see the
+  // same data as after a successful step.
+
+  BL_PROFILE("PeleC::retry_advance()");
+
+  std::string cause;
+  amrex::IntVect where;
+  if (!step_failed(get_new_data(State_Type), cause, where)) {
+    return;
+  }
+
+  // State types that the advance swapped into the old time level
+  amrex::Vector<int> swapped(num_state_type, 1);
+#ifdef PELEC_USE_REACTIONS
+  if (do_mol && do_react) {
+    swapped[Reactions_Type] = 0;
+  }
+#endif
+
+  // The old time level still holds the pre-step state, but the subcycles
+  // overwrite it, so keep a copy
+  amrex::Vector<std::unique_ptr<amrex::MultiFab>> prev_state(num_state_type);
+  for (int i = 0; i < num_state_type; ++i) {
+    if (swapped[i]) {
+      const amrex::MultiFab& S_old = get_old_data(i);
+      prev_state[i] = std::make_unique<amrex::MultiFab>(
+        grids, dmap, S_old.nComp(), S_old.nGrow(), amrex::MFInfo(), Factory());
+      amrex::MultiFab::Copy(
+        *prev_state[i], S_old, 0, 0, S_old.nComp(), S_old.nGrow());
+    }
+  }
+
+  const int finest_level = parent->finestLevel();
+  const int chem_integrator_save = chem_integrator;
+  const amrex::Real* dx = geom.CellSize();
+  const amrex::Real* prob_lo = geom.ProbLo();
+
+  int nsub = 1;
+  int retry = 0;
+  bool failed = true;
+  while (failed) {
+    ++retry;
+    if (retry > retry_max) {
+      amrex::Abort(
+        "PeleC::retry_advance: step at level " + std::to_string(level) +
+        " still fails after " + std::to_string(retry_max) +
+        " retries: " + cause);
+    }
+    nsub *= retry_subcycle_factor;
+    const amrex::Real dt_sub = dt / nsub;
+
+    std::ostringstream loc;
+    for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+      loc << (dir > 0 ? ", " : "")
+          << prob_lo[dir] + (where[dir] + 0.5) * dx[dir];
+    }
+    amrex::Print() << "PeleC::retry_advance: " << cause << " at level "
+                   << level << ", cell " << where << ", x = (" << loc.str()
+                   << "), time = " << time << ". Retry " << retry << " of "
+                   << retry_max << " with " << nsub
+                   << " subcycles of dt = " << dt_sub << std::endl;
+
+    // Roll back to the start of the step
+    if (level < finest_level && do_reflux) {
+      getFluxReg(level + 1).reset();
+    }
+    if (fine_flux_save.ok()) {
+      amrex::MultiFab::Copy(
+        getFluxReg().getFineData(), fine_flux_save, 0, 0,
+        fine_flux_save.nComp(), fine_flux_save.nGrowVect());
+    }
+    if (react_save.ok()) {
+#ifdef PELEC_USE_REACTIONS
+      amrex::MultiFab::Copy(
+        get_new_data(Reactions_Type), react_save, 0, 0, react_save.nComp(),
+        react_save.nGrow());
+#endif
+    }
+    for (int i = 0; i < num_state_type; ++i) {
+      if (swapped[i]) {
+        amrex::MultiFab& S_new = get_new_data(i);
+        amrex::MultiFab::Copy(
+          S_new, *prev_state[i], 0, 0, S_new.nComp(), S_new.nGrow());
+        state[i].setTimeLevel(time, dt_sub, dt_sub);
+      }
+    }
+
+#ifdef PELEC_USE_REACTIONS
+    if (retry_chem_integrator > 0) {
+      chem_integrator = retry_chem_integrator;
+    }
+#endif
+
+    failed = false;
+    for (int n = 0; n < nsub && !failed; ++n) {
+      const amrex::Real time_sub = time + n * dt_sub;
+      if (do_mol) {
+        do_mol_advance(time_sub, dt_sub, amr_iteration, amr_ncycle);
+      } else {
+        do_sdc_advance(time_sub, dt_sub, amr_iteration, amr_ncycle);
+      }
+      failed = step_failed(get_new_data(State_Type), cause, where);
+    }
+
+    chem_integrator = chem_integrator_save;
+  }
+
+  // Reset the old time level to the start of the step
+  for (int i = 0; i < num_state_type; ++i) {
+    if (swapped[i]) {
+      amrex::MultiFab& S_old = get_old_data(i);
+      amrex::MultiFab::Copy(
+        S_old, *prev_state[i], 0, 0, S_old.nComp(), S_old.nGrow());
+      state[i].setTimeLevel(time + dt, dt, dt);
+    }
+  }
+
+  if (verbose) {
+    amrex::Print() << "PeleC::retry_advance: step at level " << level
+                   << " succeeded after " << retry << " retries with " << nsub
+                   << " subcycles" << std::endl;
+  }
+}
+
 amrex::Real
 PeleC::do_mol_advance(
   amrex::Real time, amrex::Real dt, int amr_iteration, int amr_ncycle)
 {
   BL_PROFILE("PeleC::do_mol_advance()");
 
+  // Chemistry failures are counted over the reaction calls of this step
+  react_failures = 0;
+
   // Check that we are not asking to advance stuff we don't know to
   // if (src_list.size() > 0) amrex::Abort("Have not integrated other sources
   // into MOL advance yet");
@@ -60,25 +381,51 @@ PeleC::do_mol_advance(
 #endif
   }
 
-  if (do_mol_load_balance || do_react_load_balance) {
-    get_new_data(Work_Estimate_Type).setVal(0.0);
-  }
+  zero_box_costs();
+
+  overlap_compute_time = 0.0;
+  overlap_wait_time = 0.0;
 
   // get old and new state
   // cppcheck-suppress constVariable
   amrex::MultiFab& S_old = get_old_data(State_Type);
   amrex::MultiFab& S_new = get_new_data(State_Type);
 
-  // define sourceterm
-  amrex::MultiFab molSrc(grids, dmap, NVAR, 0, amrex::MFInfo(), Factory());
-
-  amrex::MultiFab molSrc_old;
-  amrex::MultiFab molSrc_new;
-  if (mol_iters > 1) {
-    molSrc_old.define(grids, dmap, NVAR, 0, amrex::MFInfo(), Factory());
-    molSrc_new.define(grids, dmap, NVAR, 0, amrex::MFInfo(), Factory());
+  // With a single exchange per step, the first stage is also computed on
+  // numGrow() ghost cells of the source term and of the intermediate state
+  const bool single_exchange = (mol_single_exchange != 0);
+  const int nGrowStage = single_exchange ? numGrow() : 0;
+
+  // With super-time-stepping or implicit diffusion the diffusion terms are
+  // advanced separately
+  const int terms = diffusion_split() ? hydro_terms : all_terms;
+
+  // define sourceterm, reusing the buffers of the previous steps. S_stage is
+  // only used with a single exchange, molSrc_old with mol_iters > 1 or
+  // mol_dt_control and molSrc_new with mol_iters > 1, otherwise they alias
+  // other data.
+  amrex::MultiFab& molSrc =
+    buffers.get(buf_mol_src, grids, dmap, NVAR, nGrowStage, &Factory());
+  amrex::MultiFab& S_stage =
+    single_exchange
+      ? buffers.get(buf_mol_stage, grids, dmap, NVAR, nGrowStage, &Factory())
+      : Sborder;
+  if (
+    single_exchange && mol_single_exchange_model && !single_exchange_modeled) {
+    single_exchange_cost_model(time, dt);
+    single_exchange_modeled = true;
   }
 
+  const bool keep_old_rate = (mol_iters > 1) || (mol_dt_control != 0);
+  amrex::MultiFab& molSrc_old =
+    keep_old_rate
+      ? buffers.get(buf_mol_src_old, grids, dmap, NVAR, 0, &Factory())
+      : molSrc;
+  amrex::MultiFab& molSrc_new =
+    mol_iters > 1
+      ? buffers.get(buf_mol_src_new, grids, dmap, NVAR, 0, &Factory())
+      : molSrc;
+
 #ifdef PELEC_USE_REACTIONS
   if (do_react == 0) {
     get_new_data(Reactions_Type).setVal(0.0);
@@ -95,9 +442,13 @@ PeleC::do_mol_advance(
   if (verbose) {
     amrex::Print() << "... Computing MOL source term at t^{n} " << std::endl;
   }
-  FillPatch(*this, Sborder, numGrow() + nGrowF, time, State_Type, 0, NVAR);
   amrex::Real flux_factor = 0;
-  getMOLSrcTerm(Sborder, molSrc, time, dt, flux_factor);
+  if (single_exchange) {
+    // Also builds U^{n+1,*} over the valid and ghost cells in S_stage
+    single_exchange_mol_stage(time, dt, molSrc, S_stage);
+  } else {
+    fillAndGetMOLSrcTerm(time, molSrc, time, dt, flux_factor, terms);
+  }
 
   // Build other (neither spray nor diffusion) sources at t_old
   for (int n = 0; n < src_list.size(); ++n) {
@@ -111,35 +462,40 @@ PeleC::do_mol_advance(
         src_list[n], time, dt, amr_iteration, amr_ncycle, 0, 0);
 
       // add sources to molsrc
-      amrex::MultiFab::Saxpy(
-        molSrc, 1.0, *old_sources[src_list[n]], 0, 0, NVAR, 0);
+      saxpy_source(molSrc, 1.0, *old_sources[src_list[n]], src_list[n], 0);
     }
   }
 
-  if (mol_iters > 1) {
+  if (keep_old_rate) {
     amrex::MultiFab::Copy(molSrc_old, molSrc, 0, 0, NVAR, 0);
   }
 
-  // U^* = U^n + dt*S^n
-  amrex::MultiFab::LinComb(S_new, 1.0, Sborder, 0, dt, molSrc, 0, 0, NVAR, 0);
+  if (!single_exchange) {
+    // U^* = U^n + dt*S^n
+    amrex::MultiFab::LinComb(
+      S_new, 1.0, Sborder, 0, dt, molSrc, 0, 0, NVAR, 0);
 
 #ifdef PELEC_USE_REACTIONS
-  // U^{n+1,*} = U^n + dt*S^n + dt*I_R
-  if (do_react == 1) {
-    amrex::MultiFab::Saxpy(S_new, dt, I_R, 0, FirstSpec, NUM_SPECIES, 0);
-    amrex::MultiFab::Saxpy(S_new, dt, I_R, NUM_SPECIES, Eden, 1, 0);
-  }
+    // U^{n+1,*} = U^n + dt*S^n + dt*I_R
+    if (do_react == 1) {
+      amrex::MultiFab::Saxpy(S_new, dt, I_R, 0, FirstSpec, NUM_SPECIES, 0);
+      amrex::MultiFab::Saxpy(S_new, dt, I_R, NUM_SPECIES, Eden, 1, 0);
+    }
 #endif
 
-  computeTemp(S_new, 0);
+    computeTemp(S_new, 0);
+  }
 
   // Compute S^{n+1} = MOLRhs(U^{n+1,*})
   if (verbose) {
     amrex::Print() << "... Computing MOL source term at t^{n+1} " << std::endl;
   }
-  FillPatch(*this, Sborder, numGrow() + nGrowF, time + dt, State_Type, 0, NVAR);
   flux_factor = mol_iters > 1 ? 0 : 1;
-  getMOLSrcTerm(Sborder, molSrc, time, dt, flux_factor);
+  if (single_exchange) {
+    getMOLSrcTerm(S_stage, molSrc, time, dt, flux_factor);
+  } else {
+    fillAndGetMOLSrcTerm(time + dt, molSrc, time, dt, flux_factor, terms);
+  }
 
   // Build other (neither spray nor diffusion) sources at t_new
   for (int n = 0; n < src_list.size(); ++n) {
@@ -153,23 +509,41 @@ PeleC::do_mol_advance(
         src_list[n], time + dt, dt, amr_iteration, amr_ncycle, 0, 0);
 
       // add sources to molsrc
-      amrex::MultiFab::Saxpy(
-        molSrc, 1.0, *new_sources[src_list[n]], 0, 0, NVAR, 0);
+      saxpy_source(molSrc, 1.0, *new_sources[src_list[n]], src_list[n], 0);
     }
   }
 
   // U^{n+1.**} = 0.5*(U^n + U^{n+1,*}) + 0.5*dt*S^{n+1} = U^n + 0.5*dt*S^n +
   // 0.5*dt*S^{n+1} + 0.5*dt*I_R
-  amrex::MultiFab::LinComb(S_new, 0.5, Sborder, 0, 0.5, S_old, 0, 0, NVAR, 0);
+  const amrex::MultiFab& S_star = single_exchange ? S_stage : Sborder;
+  amrex::MultiFab::LinComb(S_new, 0.5, S_star, 0, 0.5, S_old, 0, 0, NVAR, 0);
   amrex::MultiFab::Saxpy(
     S_new, 0.5 * dt, molSrc, 0, 0, NVAR,
     0); //  NOTE: If I_R=0, we are done and U_new is the final new-time state
 
+  // The forward Euler predictor U^{n+1,*} is embedded in the step, so
+  // 0.5*dt*(S^{n+1} - S^n) estimates its local error. It is taken from the
+  // MOL rates before the reaction increment is added, so that stiff
+  // chemistry does not enter the estimate.
+  if (mol_dt_control) {
+    amrex::MultiFab& S_pred =
+      buffers.get(buf_mol_dt_err, grids, dmap, NVAR, 0, &Factory());
+    amrex::MultiFab::LinComb(
+      S_pred, 1.0, S_new, 0, 0.5 * dt, molSrc_old, 0, 0, NVAR, 0);
+    amrex::MultiFab::Saxpy(S_pred, -0.5 * dt, molSrc, 0, 0, NVAR, 0);
+    mol_dt_err = amrex::max<amrex::Real>(
+      mol_dt_err, state_change(S_new, S_pred) / mol_dt_tol);
+  }
+
 #ifdef PELEC_USE_REACTIONS
   if (do_react == 1) {
     amrex::MultiFab::Saxpy(S_new, 0.5 * dt, I_R, 0, FirstSpec, NUM_SPECIES, 0);
     amrex::MultiFab::Saxpy(S_new, 0.5 * dt, I_R, NUM_SPECIES, Eden, 1, 0);
+  }
+#endif
 
+#ifdef PELEC_USE_REACTIONS
+  if (do_react == 1) {
     // F_{AD} = (1/dt)(U^{n+1,**} - U^n) - I_R = 0.5*(S^{n}+S^{n+1}(which is a
     // guess!))
     amrex::MultiFab::LinComb(
@@ -186,15 +560,40 @@ PeleC::do_mol_advance(
 
 #ifdef PELEC_USE_REACTIONS
   if (do_react == 1) {
+    // With a positive mol_tol, the correctors stop once the new state no
+    // longer changes. Each corrector then adds its fluxes to the flux
+    // registers, after the contributions of the previous one were undone.
+    const bool adaptive = (mol_tol > 0.0) && (mol_iters > 1);
+    amrex::MultiFab* S_prev =
+      adaptive ? &buffers.get(buf_iter_state, grids, dmap, NVAR, 0) : nullptr;
+    amrex::Real change = 0.0;
+    int niters = 1;
     for (int mol_iter = 2; mol_iter <= mol_iters; ++mol_iter) {
       if (verbose) {
         amrex::Print() << "... Re-computing MOL source term at t^{n+1} (iter = "
                        << mol_iter << " of " << mol_iters << ")" << std::endl;
       }
-      FillPatch(
-        *this, Sborder, numGrow() + nGrowF, time + dt, State_Type, 0, NVAR);
       flux_factor = mol_iter == mol_iters ? 1 : 0;
-      getMOLSrcTerm(Sborder, molSrc_new, time, dt, flux_factor);
+      if (adaptive) {
+        flux_factor = 1;
+        if (mol_iter == 2) {
+          save_flux_registers();
+        } else {
+          restore_flux_registers();
+        }
+        amrex::MultiFab::Copy(*S_prev, S_new, 0, 0, NVAR, 0);
+      }
+      if (single_exchange) {
+        // The corrector passes still need a regular exchange
+        {
+          TelemetryTimer tel(tel_fillpatch);
+          FillPatch(*this, S_stage, numGrow(), time + dt, State_Type, 0, NVAR);
+        }
+        getMOLSrcTerm(S_stage, molSrc_new, time, dt, flux_factor);
+      } else {
+        fillAndGetMOLSrcTerm(
+          time + dt, molSrc_new, time, dt, flux_factor, terms);
+      }
 
       // F_{AD} = (1/2)(molSrc_old + molSrc_new)
       amrex::MultiFab::LinComb(
@@ -204,17 +603,273 @@ PeleC::do_mol_advance(
       react_state(time, dt, false, &molSrc);
 
       computeTemp(S_new, 0);
+      niters++;
+
+      if (adaptive) {
+        change = state_change(get_new_data(State_Type), *S_prev);
+        if (change < mol_tol) {
+          break;
+        }
+      }
+    }
+
+    if (adaptive && verbose) {
+      amrex::Print() << "MOL at level " << level << ": " << niters << " of "
+                     << mol_iters << " iterations, change = " << change
+                     << std::endl;
     }
   }
 #endif
 
+  if (diffusion_rkl) {
+    diffusion_rkl_sweep(time, dt);
+  } else if (implicit_diffusion) {
+    implicit_diffusion_step(time, dt);
+  }
+
 #ifdef PELEC_USE_EB
   set_body_state(S_new);
 #endif
 
+  if (verbose && mol_overlap_comm && level == 0) {
+    const int IOProc = amrex::ParallelDescriptor::IOProcessorNumber();
+    amrex::Real compute_time = overlap_compute_time;
+    amrex::Real wait_time = overlap_wait_time;
+
+#ifdef AMREX_LAZY
+    Lazy::QueueReduction([=]() mutable {
+#endif
+      amrex::ParallelDescriptor::ReduceRealMax(compute_time, IOProc);
+      amrex::ParallelDescriptor::ReduceRealMax(wait_time, IOProc);
+
+      // Fraction of the exchange covered by computation on interior tiles
+      const amrex::Real efficiency =
+        (compute_time + wait_time) > 0.0
+          ? compute_time / (compute_time + wait_time)
+          : 1.0;
+      if (amrex::ParallelDescriptor::IOProcessor()) {
+        amrex::Print() << "PeleC::do_mol_advance() overlap: interior compute "
+                       << "time = " << compute_time
+                       << ", exposed exchange time = " << wait_time
+                       << ", overlap efficiency = " << efficiency << "\n";
+      }
+#ifdef AMREX_LAZY
+    });
+#endif
+  }
+
   return dt;
 }
 
+void
+PeleC::fillAndGetMOLSrcTerm(
+  amrex::Real fill_time,
+  amrex::MultiFab& MOLSrcTerm,
+  amrex::Real time,
+  amrex::Real dt,
+  amrex::Real flux_factor,
+  int terms)
+{
+  BL_PROFILE("PeleC::fillAndGetMOLSrcTerm()");
+
+  // Ghost cells on finer levels are interpolated from the coarser level, so
+  // only the exchange on level 0 is overlapped with computation
+  if (!mol_overlap_comm || level > 0) {
+    {
+      TelemetryTimer tel(tel_fillpatch);
+      FillPatch(
+        *this, Sborder, numGrow() + nGrowF, fill_time, State_Type, 0, NVAR);
+    }
+    getMOLSrcTerm(
+      Sborder, MOLSrcTerm, time, dt, flux_factor, all_tiles, 0, terms);
+    return;
+  }
+
+  // Copy the valid data and post the ghost cell exchange
+  amrex::Real strt_time = amrex::ParallelDescriptor::second();
+  const amrex::MultiFab& S = get_data(State_Type, fill_time);
+  amrex::MultiFab::Copy(Sborder, S, 0, 0, NVAR, 0);
+  Sborder.FillBoundary_nowait(geom.periodicity());
+
+  // Tiles whose stencil lies within the valid box need no ghost cells
+  getMOLSrcTerm(
+    Sborder, MOLSrcTerm, time, dt, flux_factor, interior_tiles, 0, terms);
+  overlap_compute_time += amrex::ParallelDescriptor::second() - strt_time;
+
+  {
+    TelemetryTimer tel(tel_fillpatch);
+    strt_time = amrex::ParallelDescriptor::second();
+    Sborder.FillBoundary_finish();
+    overlap_wait_time += amrex::ParallelDescriptor::second() - strt_time;
+
+    for (amrex::MFIter mfi(Sborder); mfi.isValid(); ++mfi) {
+      setPhysBoundaryValues(Sborder[mfi], State_Type, fill_time, 0, 0, NVAR);
+    }
+  }
+
+  getMOLSrcTerm(
+    Sborder, MOLSrcTerm, time, dt, flux_factor, boundary_tiles, 0, terms);
+}
+
+void
+PeleC::single_exchange_mol_stage(
+  amrex::Real time,
+  amrex::Real dt,
+  amrex::MultiFab& MOLSrcTerm,
+  amrex::MultiFab& S_stage)
+{
+  BL_PROFILE("PeleC::single_exchange_mol_stage()");
+
+  if (eb_in_domain) {
+    amrex::Abort("mol_single_exchange is not supported with EB");
+  }
+
+  const int ng = numGrow();
+
+  // Sborder and the metrics are widened on first use after (re)gridding
+  if (Sborder.nGrow() < 2 * ng) {
+    Sborder.clear();
+    Sborder.define(grids, dmap, NVAR, 2 * ng, amrex::MFInfo(), Factory());
+  }
+  if (volume.nGrow() < 2 * ng) {
+    volume.clear();
+    volume.define(
+      grids, dmap, 1, 2 * ng, amrex::MFInfo(), amrex::FArrayBoxFactory());
+    geom.GetVolume(volume);
+    for (int dir = 0; dir < AMREX_SPACEDIM; dir++) {
+      area[dir].clear();
+      area[dir].define(
+        getEdgeBoxArray(dir), dmap, 1, 2 * ng, amrex::MFInfo(),
+        amrex::FArrayBoxFactory());
+      geom.GetFaceArea(area[dir], dir);
+    }
+  }
+
+  // A single exchange provides the ghost cells for both stages
+  {
+    TelemetryTimer tel(tel_fillpatch);
+    FillPatch(*this, Sborder, 2 * ng, time, State_Type, 0, NVAR);
+  }
+
+  // S^{n} on the valid cells and ng ghost cells
+  getMOLSrcTerm(Sborder, MOLSrcTerm, time, dt, 0.0, all_tiles, ng);
+
+  // U^{n+1,*} = U^n + dt*S^n on the valid cells and ng ghost cells
+  amrex::MultiFab::LinComb(
+    S_stage, 1.0, Sborder, 0, dt, MOLSrcTerm, 0, 0, NVAR, ng);
+
+#ifdef PELEC_USE_REACTIONS
+  // U^{n+1,*} += dt*I_R, where I_R is only exchanged between boxes of this
+  // level and taken as zero in the remaining ghost cells
+  if (do_react == 1) {
+    const amrex::MultiFab& I_R = get_new_data(Reactions_Type);
+    amrex::MultiFab I_R_grown(
+      grids, dmap, I_R.nComp(), ng, amrex::MFInfo(), Factory());
+    I_R_grown.setVal(0.0);
+    amrex::MultiFab::Copy(I_R_grown, I_R, 0, 0, I_R.nComp(), 0);
+    I_R_grown.FillBoundary(geom.periodicity());
+    amrex::MultiFab::Saxpy(
+      S_stage, dt, I_R_grown, 0, FirstSpec, NUM_SPECIES, ng);
+    amrex::MultiFab::Saxpy(S_stage, dt, I_R_grown, NUM_SPECIES, Eden, 1, ng);
+  }
+#endif
+
+  computeTemp(S_stage, ng);
+
+  // Ghost cells outside the domain come from the boundary conditions
+  for (amrex::MFIter mfi(S_stage); mfi.isValid(); ++mfi) {
+    setPhysBoundaryValues(S_stage[mfi], State_Type, time + dt, 0, 0, NVAR);
+  }
+
+  amrex::MultiFab::Copy(get_new_data(State_Type), S_stage, 0, 0, NVAR, 0);
+}
+
+void
+PeleC::single_exchange_cost_model(amrex::Real time, amrex::Real dt)
+{
+  BL_PROFILE("PeleC::single_exchange_cost_model()");
+
+  const int ng = numGrow();
+  const int nrep = 3;
+
+  // Ghost cells received per exchange of ng and 2*ng ghost cells, and cells
+  // of the first stage that are computed redundantly, on this rank
+  amrex::Real nvalid = 0.0;
+  amrex::Real nghost_1 = 0.0;
+  amrex::Real nghost_2 = 0.0;
+  for (int i = 0; i < grids.size(); ++i) {
+    if (dmap[i] == amrex::ParallelDescriptor::MyProc()) {
+      const amrex::Box& bx = grids[i];
+      nvalid += bx.d_numPts();
+      nghost_1 += amrex::grow(bx, ng).d_numPts() - bx.d_numPts();
+      nghost_2 += amrex::grow(bx, 2 * ng).d_numPts() - bx.d_numPts();
+    }
+  }
+
+  amrex::MultiFab S_1(grids, dmap, NVAR, ng, amrex::MFInfo(), Factory());
+  amrex::MultiFab S_2(grids, dmap, NVAR, 2 * ng, amrex::MFInfo(), Factory());
+  amrex::MultiFab src(grids, dmap, NVAR, 0, amrex::MFInfo(), Factory());
+
+  // Best of a few repetitions of each operation
+  amrex::Real t_fill_1 = std::numeric_limits<amrex::Real>::max();
+  amrex::Real t_fill_2 = std::numeric_limits<amrex::Real>::max();
+  amrex::Real t_src = std::numeric_limits<amrex::Real>::max();
+  for (int rep = 0; rep < nrep; ++rep) {
+    amrex::ParallelDescriptor::Barrier();
+    amrex::Real strt_time = amrex::ParallelDescriptor::second();
+    FillPatch(*this, S_1, ng, time, State_Type, 0, NVAR);
+    amrex::Gpu::synchronize();
+    t_fill_1 =
+      amrex::min(t_fill_1, amrex::ParallelDescriptor::second() - strt_time);
+
+    amrex::ParallelDescriptor::Barrier();
+    strt_time = amrex::ParallelDescriptor::second();
+    FillPatch(*this, S_2, 2 * ng, time, State_Type, 0, NVAR);
+    amrex::Gpu::synchronize();
+    t_fill_2 =
+      amrex::min(t_fill_2, amrex::ParallelDescriptor::second() - strt_time);
+
+    strt_time = amrex::ParallelDescriptor::second();
+    getMOLSrcTerm(S_1, src, time, dt, 0.0);
+    amrex::Gpu::synchronize();
+    t_src = amrex::min(t_src, amrex::ParallelDescriptor::second() - strt_time);
+  }
+
+  // The slowest rank sets the pace of the step
+  amrex::ParallelDescriptor::ReduceRealMax(t_fill_1);
+  amrex::ParallelDescriptor::ReduceRealMax(t_fill_2);
+  amrex::ParallelDescriptor::ReduceRealMax(t_src);
+  amrex::ParallelDescriptor::ReduceRealMax(nvalid);
+  amrex::ParallelDescriptor::ReduceRealMax(nghost_1);
+  amrex::ParallelDescriptor::ReduceRealMax(nghost_2);
+
+  // Exchange time modeled as latency plus a cost per ghost cell,
+  // t_fill = latency + per_cell * nghost, from the two fill widths
+  const amrex::Real per_cell =
+    nghost_2 > nghost_1
+      ? amrex::max<amrex::Real>(
+          0.0, (t_fill_2 - t_fill_1) / (nghost_2 - nghost_1))
+      : 0.0;
+  const amrex::Real latency =
+    amrex::max<amrex::Real>(0.0, t_fill_1 - per_cell * nghost_1);
+  const amrex::Real compute_per_cell = nvalid > 0.0 ? t_src / nvalid : 0.0;
+
+  // Two exchanges of ng ghost cells are replaced by one of 2*ng, at the
+  // price of evaluating the first stage on ng ghost cells
+  const amrex::Real saved = 2.0 * t_fill_1 - t_fill_2;
+  const amrex::Real redundant = compute_per_cell * nghost_1;
+
+  amrex::Print() << "PeleC::single_exchange_cost_model() level " << level
+                 << ": exchange latency = " << latency
+                 << ", exchange time per ghost cell = " << per_cell
+                 << ", compute time per cell = " << compute_per_cell << "\n"
+                 << "    exchange time saved per step = " << saved
+                 << ", redundant compute time per step = " << redundant
+                 << ", mol_single_exchange "
+                 << (saved > redundant ? "pays off" : "does not pay off")
+                 << std::endl;
+}
+
 #ifdef AMREX_PARTICLES
 void
 PeleC::setSprayGridInfo(
@@ -286,6 +941,9 @@ PeleC::do_sdc_advance(
 {
   BL_PROFILE("PeleC::do_sdc_advance()");
 
+  // Chemistry failures are counted over the reaction calls of this step
+  react_failures = 0;
+
   amrex::Real dt_new = dt;
 
   // This routine will advance the old state data (called S_old here)
@@ -295,18 +953,55 @@ PeleC::do_sdc_advance(
 
   initialize_sdc_advance(time, dt, amr_iteration, amr_ncycle);
 
-  if (do_react_load_balance) {
-    get_new_data(Work_Estimate_Type).setVal(0.0);
-  }
+  zero_box_costs();
 
+  // With a positive sdc_tol, the iterations stop once the new state no longer
+  // changes. Each corrector then runs as the last iteration, after the flux
+  // register contributions of the previous one have been undone.
+  const bool adaptive = (sdc_tol > 0.0) && (sdc_iters > 1);
+  amrex::MultiFab* S_prev =
+    adaptive ? &buffers.get(buf_iter_state, grids, dmap, NVAR, 0) : nullptr;
+  amrex::Real change = 0.0;
+  int niters = 0;
   for (int sdc_iter = 0; sdc_iter < sdc_iters; ++sdc_iter) {
     if (sdc_iters > 1) {
       amrex::Print() << "SDC iteration " << sdc_iter + 1 << " of " << sdc_iters
                      << ".\n";
     }
 
+    int sdc_ncycle = sdc_iters;
+    if (adaptive && sdc_iter > 0) {
+      sdc_ncycle = sdc_iter + 1;
+      if (sdc_iter == 1) {
+        save_flux_registers();
+      } else {
+        restore_flux_registers();
+      }
+      amrex::MultiFab::Copy(*S_prev, get_new_data(State_Type), 0, 0, NVAR, 0);
+    }
+
     dt_new = do_sdc_iteration(
-      time, dt, amr_iteration, amr_ncycle, sdc_iter, sdc_iters);
+      time, dt, amr_iteration, amr_ncycle, sdc_iter, sdc_ncycle);
+    niters++;
+
+    if (adaptive && sdc_iter > 0) {
+      change = state_change(get_new_data(State_Type), *S_prev);
+      if (change < sdc_tol) {
+        break;
+      }
+    }
+  }
+
+  if (adaptive && verbose) {
+    amrex::Print() << "SDC at level " << level << ": " << niters << " of "
+                   << sdc_iters << " iterations, change = " << change
+                   << std::endl;
+  }
+
+  if (diffusion_rkl) {
+    diffusion_rkl_sweep(time, dt);
+  } else if (implicit_diffusion) {
+    implicit_diffusion_step(time, dt);
   }
 
   finalize_sdc_advance(time, dt, amr_iteration, amr_ncycle);
@@ -376,6 +1071,7 @@ PeleC::do_sdc_iteration(
 #endif
 
   if (fill_Sborder) {
+    TelemetryTimer tel(tel_fillpatch);
     FillPatch(*this, Sborder, nGrow_Sborder, time, State_Type, 0, NVAR);
   }
 
@@ -387,6 +1083,7 @@ PeleC::do_sdc_iteration(
     // TODO: Maybe move this mess into construct_old_source?
     if (do_spray_particles) {
       amrex::Gpu::LaunchSafeGuard lsg(true);
+      const amrex::Real wt = amrex::ParallelDescriptor::second();
 
       // Setup ghost particles for use in finer levels. Note that ghost
       // particles that will be used by this level have already been created,
@@ -420,6 +1117,11 @@ PeleC::do_sdc_iteration(
       if (use_ghost_parts)
         setupGhostParticles(ghost_width);
 
+      // The sort covers every level, so it follows the steps of level 0
+      if (level == 0) {
+        particleSort();
+      }
+
       // Advance the particle velocities to the half-time and the positions to
       // the new time
       if (particle_verbose)
@@ -453,6 +1155,8 @@ PeleC::do_sdc_iteration(
         theGhostPC()->moveKickDrift(
           Sborder, *old_sources[spray_src], level, dt, cur_time, false, true,
           tmp_src_width, true, where_width);
+
+      add_spray_cost(wt);
     }
 #endif
 
@@ -472,7 +1176,7 @@ PeleC::do_sdc_iteration(
 
     // Get diffusion source separate from other sources, since it requires grow
     // cells, and we may want to reuse what we fill-patched for hydro
-    if (do_diffuse) {
+    if (do_diffuse && !diffusion_split()) {
       if (verbose) {
         amrex::Print() << "... Computing diffusion terms at t^(n)" << std::endl;
       }
@@ -486,7 +1190,8 @@ PeleC::do_sdc_iteration(
     // Initialize sources at t_new by copying from t_old
     for (int n = 0; n < src_list.size(); ++n) {
       amrex::MultiFab::Copy(
-        *new_sources[src_list[n]], *old_sources[src_list[n]], 0, 0, NVAR, 0);
+        *new_sources[src_list[n]], *old_sources[src_list[n]], 0, 0,
+        source_num_comp(src_list[n]), 0);
     }
   }
 
@@ -504,12 +1209,15 @@ PeleC::do_sdc_iteration(
 
   // Now update t_new sources (diffusion separate because it requires a fill
   // patch)
-  if (do_diffuse) {
+  if (do_diffuse && !diffusion_split()) {
     if (verbose) {
       amrex::Print() << "... Computing diffusion terms at t^(n+1,"
                      << sub_iteration + 1 << ")" << std::endl;
     }
-    FillPatch(*this, Sborder, numGrow(), time + dt, State_Type, 0, NVAR);
+    {
+      TelemetryTimer tel(tel_fillpatch);
+      FillPatch(*this, Sborder, numGrow(), time + dt, State_Type, 0, NVAR);
+    }
     amrex::Real flux_factor_new = sub_iteration == sub_ncycle - 1 ? 0.5 : 0;
     getMOLSrcTerm(Sborder, *new_sources[diff_src], time, dt, flux_factor_new);
   }
@@ -535,11 +1243,13 @@ PeleC::do_sdc_iteration(
       amrex::Print() << "moveKick ... updating velocity only\n";
 
     if (!do_diffuse) { // Else, this was already done above.  No need to redo
+      TelemetryTimer tel(tel_fillpatch);
       FillPatch(*this, Sborder, nGrow_Sborder, time + dt, State_Type, 0, NVAR);
     }
 
     new_sources[spray_src]->setVal(0.);
 
+    const amrex::Real wt = amrex::ParallelDescriptor::second();
     theSprayPC()->moveKick(
       Sborder, *new_sources[spray_src], level, dt, time + dt, false, false,
       tmp_src_width);
@@ -552,6 +1262,8 @@ PeleC::do_sdc_iteration(
       theGhostPC()->moveKick(
         Sborder, *new_sources[spray_src], level, dt, time + dt, false, true,
         tmp_src_width);
+
+    add_spray_cost(wt);
   }
 #endif
 
@@ -583,10 +1295,10 @@ PeleC::construct_Snew(
 
   amrex::MultiFab::Copy(S_new, S_old, 0, 0, NVAR, ng);
   for (int n = 0; n < src_list.size(); ++n) {
-    amrex::MultiFab::Saxpy(
-      S_new, 0.5 * dt, *new_sources[src_list[n]], 0, 0, NVAR, ng);
-    amrex::MultiFab::Saxpy(
-      S_new, 0.5 * dt, *old_sources[src_list[n]], 0, 0, NVAR, ng);
+    saxpy_source(
+      S_new, 0.5 * dt, *new_sources[src_list[n]], src_list[n], ng);
+    saxpy_source(
+      S_new, 0.5 * dt, *old_sources[src_list[n]], src_list[n], ng);
   }
   if (do_hydro) {
     amrex::MultiFab::Saxpy(S_new, dt, hydro_source, 0, 0, NVAR, ng);
@@ -7,6 +7,8 @@
 // Coefficients to Edge Centers pc_compute_tangential_vel_derivs -> Computes
 // the Tangential Velocity Derivatives pc_diffusion_flux -> Computes the
 // diffusion flux per direction with the coefficients and velocity derivatives.
+// When fused_trans_parm is given, the coefficients are instead evaluated on
+// each face by pc_face_transport_coeffs, and coef is not used.
 
 void
 pc_compute_diffusion_flux(
@@ -17,7 +19,9 @@ pc_compute_diffusion_flux(
   const amrex::GpuArray<const amrex::Array4<const amrex::Real>, AMREX_SPACEDIM>
     area,
   const amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> del,
-  const int do_harmonic
+  const int do_harmonic,
+  pele::physics::transport::TransParm const* fused_trans_parm,
+  const TransportTable& table
 #ifdef PELEC_USE_EB
   ,
   const amrex::FabType typ,
@@ -68,15 +72,30 @@ pc_compute_diffusion_flux(
       }
 #endif
 
-      amrex::ParallelFor(
-        ebox, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-          amrex::Real c[dComp_lambda + 1];
-          for (int n = 0; n < dComp_lambda + 1; n++) {
-            pc_move_transcoefs_to_ec(i, j, k, n, coef, c, dir, do_harmonic);
-          }
-          pc_diffusion_flux(
-            i, j, k, q, c, tander, area[dir], flx[dir], delta, dir);
-        });
+      if (fused_trans_parm != nullptr) {
+        BL_PROFILE("PeleC::diffusion_flux_fused_transport()");
+        const TransportTable ltable = table;
+        amrex::ParallelFor(
+          ebox, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+            const int bdim[3] = {dir == 0, dir == 1, dir == 2};
+            amrex::Real c[dComp_lambda + 1];
+            pc_face_transport_coeffs(
+              i, j, k, i - bdim[0], j - bdim[1], k - bdim[2], q, c,
+              do_harmonic, fused_trans_parm, ltable);
+            pc_diffusion_flux(
+              i, j, k, q, c, tander, area[dir], flx[dir], delta, dir);
+          });
+      } else {
+        amrex::ParallelFor(
+          ebox, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+            amrex::Real c[dComp_lambda + 1];
+            for (int n = 0; n < dComp_lambda + 1; n++) {
+              pc_move_transcoefs_to_ec(i, j, k, n, coef, c, dir, do_harmonic);
+            }
+            pc_diffusion_flux(
+              i, j, k, q, c, tander, area[dir], flx[dir], delta, dir);
+          });
+      }
     }
   }
 }
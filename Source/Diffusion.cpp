@@ -6,13 +6,16 @@ PeleC::getMOLSrcTerm(
   amrex::MultiFab& MOLSrcTerm,
   amrex::Real /*time*/,
   amrex::Real dt,
-  amrex::Real flux_factor)
+  amrex::Real flux_factor,
+  int tiles,
+  int ngrow_out,
+  int terms)
 {
   BL_PROFILE("PeleC::getMOLSrcTerm()");
   BL_PROFILE_VAR_NS("diffusion_stuff", diff);
-  if (
-    diffuse_temp == 0 && diffuse_enth == 0 && diffuse_spec == 0 &&
-    diffuse_vel == 0 && do_hydro == 0) {
+  const bool with_diffusion = do_diffuse && (terms != hydro_terms);
+  const bool with_hydro = do_hydro && do_mol && (terms != diffusion_terms);
+  if (!with_diffusion && !with_hydro) {
     MOLSrcTerm.setVal(0, 0, NVAR, MOLSrcTerm.nGrow());
     return;
   }
@@ -82,11 +85,6 @@ PeleC::getMOLSrcTerm(
     dynamic_cast<amrex::EBFArrayBoxFactory const&>(S.Factory());
   auto const& flags = fact.getMultiEBCellFlagFab();
   // amrex::Elixir flags_eli = flags.elixir();
-  amrex::MultiFab* cost = nullptr;
-
-  if (do_mol_load_balance) {
-    cost = &(get_new_data(Work_Estimate_Type));
-  }
 
   amrex::EBFluxRegister* fr_as_crse = nullptr;
   if (do_reflux && level < parent->finestLevel()) {
@@ -100,8 +98,34 @@ PeleC::getMOLSrcTerm(
 
 #endif
 
+  AMREX_ASSERT(ngrow_out == 0 || (flux_factor == 0 && !eb_in_domain));
+  AMREX_ASSERT(MOLSrcTerm.nGrow() >= ngrow_out);
+  AMREX_ASSERT(S.nGrow() - ngrow_out >= numGrow());
+
+  // When overlapping communication, tiles are split into those that only
+  // need valid data and those that need ghost cells
+  amrex::MFItInfo mfi_info;
+  if (tiles != all_tiles) {
+    mfi_info.EnableTiling(amrex::IntVect(mol_overlap_tile_size));
+  } else if (amrex::TilingIfNotGPU()) {
+    mfi_info.EnableTiling();
+  }
+
+  // Tiles made only of covered cells away from the coarse-fine interface
+  // are averaged down over, so their source term is simply zeroed
+  const amrex::iMultiFab* covered =
+    ngrow_out == 0 ? build_covered_mask() : nullptr;
+
+  // Time spent by the tiles in the diffusion, hydro and redistribution parts
+  // of the source term, for the telemetry
+  const amrex::Real tel_start = telemetry_clock();
+  amrex::Real t_diffusion = 0.0;
+  amrex::Real t_hydro = 0.0;
+  amrex::Real t_redistribution = 0.0;
+
 #ifdef _OPENMP
-#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())               \
+    reduction(+:t_diffusion,t_hydro,t_redistribution)
 #endif
   {
     // amrex::IArrayBox bcMask[AMREX_SPACEDIM];
@@ -116,25 +140,38 @@ PeleC::getMOLSrcTerm(
     // const int* domain_lo = geom.Domain().loVect();
     // const int* domain_hi = geom.Domain().hiVect();
 
-    for (amrex::MFIter mfi(MOLSrcTerm, amrex::TilingIfNotGPU()); mfi.isValid();
-         ++mfi) {
-      const amrex::Box vbox = mfi.tilebox();
-      int ng = S.nGrow();
+    for (amrex::MFIter mfi(MOLSrcTerm, mfi_info); mfi.isValid(); ++mfi) {
+      // The source term may be requested on ngrow_out ghost cells, which
+      // uses up that many of the ghost cells of S
+      const amrex::Box vbox = mfi.growntilebox(ngrow_out);
+      int ng = S.nGrow() - ngrow_out;
+      if (tiles != all_tiles) {
+        const bool interior = mfi.validbox().contains(amrex::grow(vbox, ng));
+        if (interior != (tiles == interior_tiles)) {
+          continue;
+        }
+      }
       const amrex::Box gbox = amrex::grow(vbox, ng);
       const amrex::Box cbox = amrex::grow(vbox, ng - 1);
       auto const& MOLSrc = MOLSrcTerm.array(mfi);
 
+      if (
+        (covered != nullptr) &&
+        ((*covered)[mfi].min<amrex::RunOn::Device>(vbox, 0) == 1)) {
+        setV(vbox, NVAR, MOLSrc, 0);
+        continue;
+      }
+
+      const amrex::Real wt = amrex::ParallelDescriptor::second();
+      amrex::Real t_tile = telemetry_clock();
+
 #ifdef PELEC_USE_EB
-      amrex::Real wt = amrex::ParallelDescriptor::second();
       const auto& flag_fab = flags[mfi];
       // amrex::Elixir flag_fab_eli = flag_fab.elixir();
       amrex::FabType typ = flag_fab.getType(vbox);
       if (typ == amrex::FabType::covered) {
         setV(vbox, NVAR, MOLSrc, 0);
-        if (do_mol_load_balance && cost) {
-          wt = (amrex::ParallelDescriptor::second() - wt) / vbox.d_numPts();
-          (*cost)[mfi].plus<amrex::RunOn::Device>(wt, vbox);
-        }
+        add_box_cost(cost_mol, mfi, wt);
         continue;
       }
       // Note on typ: if interior cells (vbox) are all covered, no need to
@@ -164,10 +201,21 @@ PeleC::getMOLSrcTerm(
       int nqaux = NQAUX > 0 ? NQAUX : 1;
       amrex::FArrayBox q(gbox, QVAR);
       amrex::FArrayBox qaux(gbox, nqaux);
-      amrex::FArrayBox coeff_cc(gbox, nCompTr);
       amrex::Elixir qeli = q.elixir();
       amrex::Elixir qauxeli = qaux.elixir();
-      amrex::Elixir coefeli = coeff_cc.elixir();
+
+      // With fused transport, the coefficients are evaluated on the faces in
+      // the flux kernel, unless cut cells need them for the EB fluxes
+      bool fused_transport = diffusion_fused_transport != 0;
+#ifdef PELEC_USE_EB
+      fused_transport = fused_transport && Ncut == 0;
+#endif
+      amrex::FArrayBox coeff_cc;
+      amrex::Elixir coefeli;
+      if (with_diffusion && !fused_transport) {
+        coeff_cc.resize(gbox, nCompTr);
+        coefeli = coeff_cc.elixir();
+      }
       auto const& sar = S.array(mfi);
       auto const& qar = q.array();
       auto const& qauxar = qaux.array();
@@ -219,7 +267,7 @@ PeleC::getMOLSrcTerm(
       */
       // Compute transport coefficients, coincident with Q
       auto const& coe_cc = coeff_cc.array();
-      {
+      if (with_diffusion && !fused_transport) {
         auto const& qar_yin = q.array(QFS);
         auto const& qar_Tin = q.array(QTEMP);
         auto const& qar_rhoin = q.array(QRHO);
@@ -231,12 +279,9 @@ PeleC::getMOLSrcTerm(
         // Get Transport coefs on GPU.
         pele::physics::transport::TransParm const* ltransparm =
           pele::physics::transport::trans_parm_g;
-        amrex::launch(gbox, [=] AMREX_GPU_DEVICE(amrex::Box const& tbx) {
-          auto trans = pele::physics::PhysicsType::transport();
-          trans.get_transport_coeffs(
-            tbx, qar_yin, qar_Tin, qar_rhoin, coe_rhoD, coe_mu, coe_xi,
-            coe_lambda, ltransparm);
-        });
+        pc_get_transport_coeffs(
+          gbox, qar_yin, qar_Tin, qar_rhoin, coe_rhoD, coe_mu, coe_xi,
+          coe_lambda, ltransparm, transport_table);
       }
 
       amrex::FArrayBox flux_ec[AMREX_SPACEDIM];
@@ -261,16 +306,18 @@ PeleC::getMOLSrcTerm(
       auto const& Dterm = Dfab.array();
       setV(cbox, NVAR, Dterm, 0.0);
 
-      pc_compute_diffusion_flux(
-        cbox, qar, coe_cc, flx, area_arr, dx, do_harmonic
+      if (with_diffusion) {
+        pc_compute_diffusion_flux(
+          cbox, qar, coe_cc, flx, area_arr, dx, do_harmonic,
+          fused_transport ? pele::physics::transport::trans_parm_g : nullptr,
+          transport_table
 #ifdef PELEC_USE_EB
-        ,
-        typ, Ncut, d_sv_eb_bndry_geom, flags.array(mfi)
+          ,
+          typ, Ncut, d_sv_eb_bndry_geom, flags.array(mfi)
 #endif
-      );
+        );
 
-      // Compute flux divergence (1/Vol).Div(F.A)
-      {
+        // Compute flux divergence (1/Vol).Div(F.A)
         BL_PROFILE("PeleC::pc_flux_div()");
         auto const& vol = volume.array(mfi);
         amrex::ParallelFor(
@@ -321,7 +368,9 @@ PeleC::getMOLSrcTerm(
         AMREX_ASSERT(Nvals == Ncut);
         AMREX_ASSERT(nFlux == Ncut);
 
-        if (eb_isothermal && (diffuse_temp != 0 || diffuse_enth != 0)) {
+        if (
+          with_diffusion && eb_isothermal &&
+          (diffuse_temp != 0 || diffuse_enth != 0)) {
           {
             BL_PROFILE("PeleC::pc_apply_eb_boundry_flux_stencil()");
             pc_apply_eb_boundry_flux_stencil(
@@ -331,7 +380,7 @@ PeleC::getMOLSrcTerm(
           }
         }
         // Compute momentum transfer at no-slip EB wall
-        if (eb_noslip && diffuse_vel == 1) {
+        if (with_diffusion && eb_noslip && diffuse_vel == 1) {
           {
             BL_PROFILE("PeleC::pc_apply_eb_boundry_visc_flux_stencil()");
             pc_apply_eb_boundry_visc_flux_stencil(
@@ -345,6 +394,11 @@ PeleC::getMOLSrcTerm(
 #endif
 
       BL_PROFILE_VAR_STOP(diff);
+      {
+        const amrex::Real t = telemetry_clock();
+        t_diffusion += t - t_tile;
+        t_tile = t;
+      }
 
       // At this point flux_ec contains the diffusive fluxes in each direction
       // at face centers for the (potentially partially covered) grid-aligned
@@ -353,7 +407,7 @@ PeleC::getMOLSrcTerm(
       // Also, Dterm currently contains the divergence of the face-centered
       // diffusion fluxes.  Increment this with the divergence of the
       // face-centered hyperbloic fluxes.
-      if (do_hydro && do_mol) {
+      if (with_hydro) {
         // amrex::FArrayBox flatn(cbox, 1);
         // amrex::Elixir flatn_eli;
         // flatn_eli = flatn.elixir();
@@ -602,8 +656,8 @@ PeleC::getMOLSrcTerm(
         }
       }
 
-      // Extrapolate to GhostCells
-      if (MOLSrcTerm.nGrow() > 0) {
+      // Extrapolate to GhostCells, unless they were computed above
+      if (MOLSrcTerm.nGrow() > 0 && ngrow_out == 0) {
         BL_PROFILE("PeleC::diffextrap()");
         const int mg = MOLSrcTerm.nGrow();
         const auto* low = vbox.loVect();
@@ -626,6 +680,12 @@ PeleC::getMOLSrcTerm(
           });
       }
 
+      {
+        const amrex::Real t = telemetry_clock();
+        t_hydro += t - t_tile;
+        t_tile = t;
+      }
+
       // EB redistribution
 #ifdef PELEC_USE_EB
       if (typ != amrex::FabType::regular) {
@@ -665,13 +725,19 @@ PeleC::getMOLSrcTerm(
 
       copy_array4(vbox, NVAR, Dterm, MOLSrc);
 
-#ifdef PELEC_USE_EB
-      if (do_mol_load_balance && cost) {
-        amrex::Gpu::streamSynchronize();
-        wt = (amrex::ParallelDescriptor::second() - wt) / vbox.d_numPts();
-        (*cost)[mfi].plus<amrex::RunOn::Device>(wt, vbox);
-      }
-#endif
+      t_redistribution += telemetry_clock() - t_tile;
+
+      add_box_cost(cost_mol, mfi, wt);
     }
   }
+
+  // Share the wall time of the call among the parts measured on the tiles
+  const amrex::Real t_tiles = t_diffusion + t_hydro + t_redistribution;
+  if (t_tiles > 0.0) {
+    const amrex::Real t_wall = telemetry_clock() - tel_start;
+    add_telemetry_time(tel_diffusion, t_wall * t_diffusion / t_tiles);
+    add_telemetry_time(tel_hydro, t_wall * t_hydro / t_tiles);
+    add_telemetry_time(
+      tel_redistribution, t_wall * t_redistribution / t_tiles);
+  }
 }
@@ -0,0 +1,137 @@
+#include "PeleC.H"
+#include "IndexDefines.H"
+#include "Timestep.H"
+
+// Runge-Kutta-Legendre super-time-stepping of the diffusion terms.
+//
+// After the hydrodynamic step, S_new is advanced over dt by the diffusion
+// terms alone, dU/dt = L(U), with the s-stage RKL1 or RKL2 scheme of Meyer,
+// Balsara & Aslam (2014):
+//
+//    Y_0 = U,   Y_1 = Y_0 + mt_1 dt L(Y_0),
+//    Y_j = mu_j Y_{j-1} + nu_j Y_{j-2} + (1 - mu_j - nu_j) Y_0
+//          + mt_j dt L(Y_{j-1}) + gt_j dt L(Y_0),     j = 2, ..., s
+//
+// which is stable for dt up to (s^2 + s) / 2 (RKL1) or (s^2 + s - 2) / 4
+// (RKL2) times the forward Euler limit, so the cost grows like the square
+// root of the ratio of dt to the diffusive limit. The final stage is a linear
+// combination Y_s = Y_0 + dt sum_k w_k L(Y_k), so the diffusive fluxes of the
+// evaluation at Y_k enter the flux registers with weight w_k, and reflux
+// recovers the time-integrated diffusive flux under subcycling.
+
+namespace {
+struct rkl_coeffs
+{
+  amrex::Real mu = 0.0;
+  amrex::Real nu = 0.0;
+  amrex::Real mt = 0.0;
+  amrex::Real gt = 0.0;
+};
+
+amrex::Vector<rkl_coeffs>
+rkl_stage_coeffs(const int order, const int s)
+{
+  amrex::Vector<rkl_coeffs> c(s + 1);
+  if (order == 1) {
+    const amrex::Real w1 = 2.0 / (s * s + s);
+    c[1].mt = w1;
+    for (int j = 2; j <= s; j++) {
+      c[j].mu = (2.0 * j - 1.0) / j;
+      c[j].nu = (1.0 - j) / j;
+      c[j].mt = c[j].mu * w1;
+    }
+  } else {
+    const amrex::Real w1 = 4.0 / (s * s + s - 2);
+    amrex::Vector<amrex::Real> b(s + 1, 1.0 / 3.0);
+    for (int j = 2; j <= s; j++) {
+      b[j] = (j * j + j - 2.0) / (2.0 * j * (j + 1.0));
+    }
+    c[1].mt = b[1] * w1;
+    for (int j = 2; j <= s; j++) {
+      c[j].mu = (2.0 * j - 1.0) / j * b[j] / b[j - 1];
+      c[j].nu = -(j - 1.0) / j * b[j] / b[j - 2];
+      c[j].mt = c[j].mu * w1;
+      c[j].gt = -(1.0 - b[j - 1]) * c[j].mt;
+    }
+  }
+  return c;
+}
+
+// Weights w_k of L(Y_k) in Y_s = Y_0 + dt sum_k w_k L(Y_k)
+amrex::Vector<amrex::Real>
+rkl_flux_weights(const amrex::Vector<rkl_coeffs>& c)
+{
+  const int s = static_cast<int>(c.size()) - 1;
+  amrex::Vector<amrex::Real> wm2(s, 0.0);
+  amrex::Vector<amrex::Real> wm1(s, 0.0);
+  wm1[0] = c[1].mt;
+  for (int j = 2; j <= s; j++) {
+    amrex::Vector<amrex::Real> w(s, 0.0);
+    for (int k = 0; k < s; k++) {
+      w[k] = c[j].mu * wm1[k] + c[j].nu * wm2[k];
+    }
+    w[j - 1] += c[j].mt;
+    w[0] += c[j].gt;
+    wm2 = wm1;
+    wm1 = w;
+  }
+  return wm1;
+}
+} // namespace
+
+void
+PeleC::diffusion_rkl_sweep(amrex::Real time, amrex::Real dt)
+{
+  BL_PROFILE("PeleC::diffusion_rkl_sweep()");
+
+  amrex::Real strt_time = amrex::ParallelDescriptor::second();
+
+  amrex::MultiFab& S_new = get_new_data(State_Type);
+
+  amrex::Real estdt_diff = estDiffusiveTimeStep(S_new);
+  amrex::ParallelDescriptor::ReduceRealMin(estdt_diff);
+  const int s = pc_rkl_stages(diffusion_rkl, dt / (cfl * estdt_diff));
+  const amrex::Vector<rkl_coeffs> c = rkl_stage_coeffs(diffusion_rkl, s);
+  const amrex::Vector<amrex::Real> w = rkl_flux_weights(c);
+
+  amrex::MultiFab Y0(grids, dmap, NVAR, 0, amrex::MFInfo(), Factory());
+  amrex::MultiFab Yjm1(grids, dmap, NVAR, 0, amrex::MFInfo(), Factory());
+  amrex::MultiFab Yjm2(grids, dmap, NVAR, 0, amrex::MFInfo(), Factory());
+  amrex::MultiFab L0(grids, dmap, NVAR, 0, amrex::MFInfo(), Factory());
+  amrex::MultiFab L(grids, dmap, NVAR, 0, amrex::MFInfo(), Factory());
+
+  amrex::MultiFab::Copy(Y0, S_new, 0, 0, NVAR, 0);
+  amrex::MultiFab::Copy(Yjm1, S_new, 0, 0, NVAR, 0);
+
+  // Y_1 = Y_0 + mt_1 dt L(Y_0)
+  fillAndGetMOLSrcTerm(time + dt, L0, time, dt, w[0], diffusion_terms);
+  amrex::MultiFab::Saxpy(S_new, c[1].mt * dt, L0, 0, 0, NVAR, 0);
+  computeTemp(S_new, 0);
+
+  for (int j = 2; j <= s; j++) {
+    std::swap(Yjm2, Yjm1);
+    amrex::MultiFab::Copy(Yjm1, S_new, 0, 0, NVAR, 0);
+
+    fillAndGetMOLSrcTerm(time + dt, L, time, dt, w[j - 1], diffusion_terms);
+
+    amrex::MultiFab::LinComb(
+      S_new, c[j].mu, Yjm1, 0, c[j].nu, Yjm2, 0, 0, NVAR, 0);
+    amrex::MultiFab::Saxpy(S_new, 1.0 - c[j].mu - c[j].nu, Y0, 0, 0, NVAR, 0);
+    amrex::MultiFab::Saxpy(S_new, c[j].mt * dt, L, 0, 0, NVAR, 0);
+    if (c[j].gt != 0.0) {
+      amrex::MultiFab::Saxpy(S_new, c[j].gt * dt, L0, 0, 0, NVAR, 0);
+    }
+    computeTemp(S_new, 0);
+  }
+
+  if (verbose) {
+    const int IOProc = amrex::ParallelDescriptor::IOProcessorNumber();
+    amrex::Real run_time = amrex::ParallelDescriptor::second() - strt_time;
+    amrex::ParallelDescriptor::ReduceRealMax(run_time, IOProc);
+    amrex::Print() << "PeleC::diffusion_rkl_sweep() at level " << level
+                   << ": RKL" << diffusion_rkl << " with " << s
+                   << " stages for dt / dt_diffusive = "
+                   << dt / (cfl * estdt_diff) << ", time: " << run_time
+                   << "\n";
+  }
+}
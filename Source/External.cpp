@@ -73,6 +73,7 @@ PeleC::fill_ext_source(
     }
 #endif
 
+    const amrex::Real wt = amrex::ParallelDescriptor::second();
     // auto const& So = state_old.array(mfi);
     // auto const& Sn = state_new.array(mfi);
     auto const& Farr = ext_src.array(mfi);
@@ -82,5 +83,7 @@ PeleC::fill_ext_source(
       bx, NVAR, [=] AMREX_GPU_DEVICE(int i, int j, int k, int n) noexcept {
         Farr(i, j, k, n) = 0.0;
       });
+
+    add_box_cost(cost_sources, mfi, wt);
   }
 }
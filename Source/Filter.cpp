@@ -461,27 +461,132 @@ Filter::apply_filter(
   const int ncnt,
   const int /*ncomp*/)
 {
-  const auto q = in.array();
-  auto qh = out.array();
-  setC(box, nstart, ncnt, qh, 0.0);
-  amrex::Gpu::DeviceVector<amrex::Real> weights(_weights.size());
-  amrex::Real* w = weights.data();
+  const amrex::Array4<const amrex::Real> q(
+    in.const_array(), nstart, ncnt - nstart);
+  const amrex::Array4<amrex::Real> qh(out.array(), nstart, ncnt - nstart);
+  apply_filter_fused(box, 1, &q, &qh);
+}
+
+// Run the filtering operation on several FABs at once
+void
+Filter::apply_filter(
+  const amrex::Box& box,
+  const amrex::Vector<const amrex::FArrayBox*>& in,
+  const amrex::Vector<amrex::FArrayBox*>& out)
+{
+  AMREX_ASSERT(in.size() == out.size());
+
+  const int nfields = static_cast<int>(in.size());
+  amrex::Vector<amrex::Array4<const amrex::Real>> q(nfields);
+  amrex::Vector<amrex::Array4<amrex::Real>> qh(nfields);
+  for (int f = 0; f < nfields; f++) {
+    AMREX_ASSERT(in[f]->nComp() == out[f]->nComp());
+    q[f] = in[f]->const_array();
+    qh[f] = out[f]->array();
+  }
+  apply_filter(box, q, qh);
+}
+
+// Run the filtering operation on several arrays at once, which may be
+// component slices of FABs
+void
+Filter::apply_filter(
+  const amrex::Box& box,
+  const amrex::Vector<amrex::Array4<const amrex::Real>>& in,
+  const amrex::Vector<amrex::Array4<amrex::Real>>& out)
+{
+  BL_PROFILE("Filter::apply_filter()");
+  AMREX_ASSERT(in.size() == out.size());
+
+  const int nfields = static_cast<int>(in.size());
+  const int nmax = max_fused;
+  for (int f = 0; f < nfields; f += nmax) {
+    apply_filter_fused(box, amrex::min(nmax, nfields - f), &in[f], &out[f]);
+  }
+}
+
+// The weights are only copied to the device once per filter
+void
+Filter::copy_weights_to_device()
+{
+  _d_weights.resize(_weights.size());
   amrex::Gpu::copy(
     amrex::Gpu::hostToDevice, _weights.begin(), _weights.end(),
-    weights.begin());
-
-  const int captured_ngrow = _ngrow;
-  amrex::ParallelFor(
-    box, ncnt - nstart,
-    [=] AMREX_GPU_DEVICE(int i, int j, int k, int nc) noexcept {
-      for (int n = -captured_ngrow; n <= captured_ngrow; n++) {
-        for (int m = -captured_ngrow; m <= captured_ngrow; m++) {
-          for (int l = -captured_ngrow; l <= captured_ngrow; l++) {
-            qh(i, j, k, nc + nstart) +=
-              w[l + captured_ngrow] * w[m + captured_ngrow] *
-              w[n + captured_ngrow] * q(i + l, j + m, k + n, nc);
-          }
+    _d_weights.begin());
+}
+
+// The filter is a tensor product of 1D filters, so it is applied as one 1D
+// pass per direction. Each pass covers the box grown in the directions still
+// to be filtered, and all components of all the fields in a single launch.
+void
+Filter::apply_filter_fused(
+  const amrex::Box& box,
+  const int nfields,
+  const amrex::Array4<const amrex::Real>* in,
+  const amrex::Array4<amrex::Real>* out)
+{
+  AMREX_ASSERT(nfields <= max_fused);
+
+  amrex::GpuArray<amrex::Array4<const amrex::Real>, max_fused> qin;
+  amrex::GpuArray<amrex::Array4<amrex::Real>, max_fused> qout;
+  amrex::GpuArray<int, max_fused + 1> offset;
+  offset[0] = 0;
+  for (int f = 0; f < nfields; f++) {
+    qin[f] = in[f];
+    qout[f] = out[f];
+    offset[f + 1] = offset[f] + out[f].nComp();
+  }
+  const int ntot = offset[nfields];
+
+  const int ng = _ngrow;
+  const amrex::Real* w = _d_weights.data();
+
+  amrex::FArrayBox tmp[AMREX_SPACEDIM];
+  amrex::Elixir tmp_eli[AMREX_SPACEDIM];
+
+  for (int dir = 0; dir < AMREX_SPACEDIM; dir++) {
+    amrex::Box pbox(box);
+    for (int d = dir + 1; d < AMREX_SPACEDIM; d++) {
+      pbox.grow(d, ng);
+    }
+
+    const bool first = (dir == 0);
+    const bool last = (dir == AMREX_SPACEDIM - 1);
+    const int di = (dir == 0) ? 1 : 0;
+    const int dj = (dir == 1) ? 1 : 0;
+    const int dk = (dir == 2) ? 1 : 0;
+
+    amrex::Array4<const amrex::Real> src;
+    if (!first) {
+      src = tmp[dir - 1].const_array();
+    }
+    amrex::Array4<amrex::Real> dst;
+    if (!last) {
+      tmp[dir].resize(pbox, ntot);
+      tmp_eli[dir] = tmp[dir].elixir();
+      dst = tmp[dir].array();
+    }
+
+    amrex::ParallelFor(
+      pbox, ntot, [=] AMREX_GPU_DEVICE(int i, int j, int k, int n) noexcept {
+        int f = 0;
+        while (n >= offset[f + 1]) {
+          f++;
+        }
+        const int nc = n - offset[f];
+
+        amrex::Real sum = 0.0;
+        for (int l = -ng; l <= ng; l++) {
+          sum += w[l + ng] *
+                 (first ? qin[f](i + l * di, j + l * dj, k + l * dk, nc)
+                        : src(i + l * di, j + l * dj, k + l * dk, n));
         }
-      }
-    });
+
+        if (last) {
+          qout[f](i, j, k, nc) = sum;
+        } else {
+          dst(i, j, k, n) = sum;
+        }
+      });
+  }
 }
@@ -44,7 +44,7 @@ PeleC::fill_forcing_source(
 #endif
   ,
   const amrex::MultiFab& state_new,
-  amrex::MultiFab& forcing_src,
+  amrex::MultiFab& forcing,
   int ng)
 {
 #ifdef PELEC_USE_EB
@@ -56,7 +56,7 @@ PeleC::fill_forcing_source(
 #ifdef _OPENMP
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
-  for (amrex::MFIter mfi(forcing_src, amrex::TilingIfNotGPU()); mfi.isValid();
+  for (amrex::MFIter mfi(forcing, amrex::TilingIfNotGPU()); mfi.isValid();
        ++mfi) {
     const amrex::Box& bx = mfi.growntilebox(ng);
 
@@ -68,8 +68,9 @@ PeleC::fill_forcing_source(
     }
 #endif
 
+    const amrex::Real wt = amrex::ParallelDescriptor::second();
     auto const& sarr = state_new.array(mfi);
-    auto const& src = forcing_src.array(mfi);
+    auto const& src = forcing.array(mfi);
 
     amrex::Real u0 = 0.0;
     amrex::Real v0 = 0.0;
@@ -82,14 +83,17 @@ PeleC::fill_forcing_source(
     force = PeleC::h_prob_parm_device->forcing_force;
 #endif
 
-    // Evaluate the linear forcing term
+    // Evaluate the linear forcing term. The source holds the momentum only.
+    const int scomp = source_start_comp(forcing_src);
     amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-      src(i, j, k, UMX) =
+      src(i, j, k, UMX - scomp) =
         force * sarr(i, j, k, URHO) * (sarr(i, j, k, UMX) - u0);
-      src(i, j, k, UMY) =
+      src(i, j, k, UMY - scomp) =
         force * sarr(i, j, k, URHO) * (sarr(i, j, k, UMY) - v0);
-      src(i, j, k, UMZ) =
+      src(i, j, k, UMZ - scomp) =
         force * sarr(i, j, k, URHO) * (sarr(i, j, k, UMZ) - w0);
     });
+
+    add_box_cost(cost_sources, mfi, wt);
   }
 }
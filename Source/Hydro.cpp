@@ -17,6 +17,7 @@ PeleC::construct_hydro_source(
     }
     hydro_source.setVal(0);
   } else {
+    TelemetryTimer tel(tel_hydro);
 
     if (verbose && amrex::ParallelDescriptor::IOProcessor()) {
       amrex::Print() << "... Computing hydro advance" << std::endl;
@@ -27,10 +28,10 @@ PeleC::construct_hydro_source(
     int ng = 0; // TODO: This is currently the largest ngrow of the source
                 // data...maybe this needs fixing?
     for (int n = 0; n < src_list.size(); ++n) {
-      amrex::MultiFab::Saxpy(
-        sources_for_hydro, 0.5, *new_sources[src_list[n]], 0, 0, NVAR, ng);
-      amrex::MultiFab::Saxpy(
-        sources_for_hydro, 0.5, *old_sources[src_list[n]], 0, 0, NVAR, ng);
+      saxpy_source(
+        sources_for_hydro, 0.5, *new_sources[src_list[n]], src_list[n], ng);
+      saxpy_source(
+        sources_for_hydro, 0.5, *old_sources[src_list[n]], src_list[n], ng);
     }
 #ifdef PELEC_USE_REACTIONS
     // Add I_R terms to advective forcing
@@ -107,6 +108,7 @@ PeleC::construct_hydro_source(
       for (amrex::MFIter mfi(S_new, amrex::TilingIfNotGPU()); mfi.isValid();
            ++mfi) {
 
+        const amrex::Real wt = amrex::ParallelDescriptor::second();
         const amrex::Box& bx = mfi.tilebox();
         const amrex::Box& qbx = amrex::grow(bx, numGrow() + nGrowF);
         const amrex::Box& fbx = amrex::grow(bx, nGrowF);
@@ -273,6 +275,8 @@ PeleC::construct_hydro_source(
           }
         }
         BL_PROFILE_VAR_STOP(crno);
+
+        add_box_cost(cost_godunov, mfi, wt);
       }
     }
 
@@ -23,6 +23,7 @@
 #include "PeleC.H"
 #include "IO.H"
 #include "IndexDefines.H"
+#include "Utilities.H"
 
 // PeleC maintains an internal checkpoint version numbering system.
 // This allows us to maintain backwards compatibility with checkpoints
@@ -38,6 +39,71 @@ int input_version = -1;
 int current_version = 1;
 std::string body_state_filename = "body_state.fab";
 amrex::Real vfraceps = 0.000001;
+
+// Copy the state data S into a lightweight checkpoint. With float_scalars,
+// the components from UFA on go into flt in single precision.
+void
+store_light_checkpoint(
+  const amrex::MultiFab& S,
+  amrex::MultiFab& dbl,
+  amrex::FabArray<amrex::BaseFab<float>>& flt,
+  const bool float_scalars,
+  const amrex::FabFactory<amrex::FArrayBox>& factory)
+{
+  const amrex::BoxArray& ba = S.boxArray();
+  const amrex::DistributionMapping& dm = S.DistributionMap();
+  const int ndouble = float_scalars ? UFA : S.nComp();
+  if (
+    (dbl.boxArray() != ba) || (dbl.DistributionMap() != dm) ||
+    (dbl.nComp() != ndouble)) {
+    dbl.define(ba, dm, ndouble, 0, amrex::MFInfo(), factory);
+  }
+  amrex::MultiFab::Copy(dbl, S, 0, 0, ndouble, 0);
+
+  if (!float_scalars) {
+    flt.clear();
+    return;
+  }
+  if ((flt.boxArray() != ba) || (flt.DistributionMap() != dm)) {
+    flt.define(ba, dm, NVAR - UFA, 0);
+  }
+#ifdef _OPENMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+  for (amrex::MFIter mfi(flt, amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+    const amrex::Box& bx = mfi.tilebox();
+    auto const& sarr = S.const_array(mfi);
+    auto const& farr = flt.array(mfi);
+    amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+      pc_store_float_scalars(i, j, k, sarr, farr);
+    });
+  }
+}
+
+// Copy a lightweight checkpoint back into the state data S
+void
+load_light_checkpoint(
+  amrex::MultiFab& S,
+  const amrex::MultiFab& dbl,
+  const amrex::FabArray<amrex::BaseFab<float>>& flt)
+{
+  amrex::MultiFab::Copy(S, dbl, 0, 0, dbl.nComp(), 0);
+  if (dbl.nComp() == S.nComp()) {
+    return;
+  }
+  AMREX_ALWAYS_ASSERT(dbl.nComp() == UFA && S.nComp() == NVAR);
+#ifdef _OPENMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+  for (amrex::MFIter mfi(S, amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+    const amrex::Box& bx = mfi.tilebox();
+    auto const& sarr = S.array(mfi);
+    auto const& farr = flt.const_array(mfi);
+    amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+      pc_load_float_scalars(i, j, k, farr, sarr);
+    });
+  }
+}
 } // namespace
 
 // I/O routines for PeleC
@@ -103,10 +169,11 @@ PeleC::restart(amrex::Amr& papa, std::istream& is, bool bReadSpecial)
       newGrow = 1;
     }
 #endif
+    const int ncomp = source_num_comp(src_list[n]);
     old_sources[src_list[n]] = std::make_unique<amrex::MultiFab>(
-      grids, dmap, NVAR, oldGrow, amrex::MFInfo(), Factory());
+      grids, dmap, ncomp, oldGrow, amrex::MFInfo(), Factory());
     new_sources[src_list[n]] = std::make_unique<amrex::MultiFab>(
-      grids, dmap, NVAR, newGrow, amrex::MFInfo(), Factory());
+      grids, dmap, ncomp, newGrow, amrex::MFInfo(), Factory());
   }
 
   if (do_hydro) {
@@ -242,6 +309,7 @@ PeleC::checkPoint(
   amrex::VisMF::How how,
   bool /*dump_old_default*/)
 {
+  TelemetryTimer tel(tel_io);
   amrex::AmrLevel::checkPoint(dir, os, how, dump_old);
 
 #ifdef AMREX_PARTICLES
@@ -340,6 +408,118 @@ PeleC::checkPoint(
 #endif
 }
 
+// Lightweight checkpoints keep a copy of the state data of each level in
+// memory. They cost a device-local copy and no I/O, so they can be taken much
+// more often than the full checkpoints written through amr.check_int. If the
+// run fails, every level can be rolled back to the last lightweight
+// checkpoint, which is then promoted to a full, restartable checkpoint.
+void
+PeleC::writeLightCheckpoint()
+{
+  BL_PROFILE("PeleC::writeLightCheckpoint()");
+  TelemetryTimer tel(tel_io);
+
+  const int num_state_type = desc_lst.size();
+  light_ckpt_new.resize(num_state_type);
+  light_ckpt_old.resize(num_state_type);
+
+  for (int typ = 0; typ < num_state_type; ++typ) {
+    const bool float_scalars =
+      (typ == State_Type) && (light_check_float_scalars != 0);
+    amrex::FabArray<amrex::BaseFab<float>> unused;
+    store_light_checkpoint(
+      get_new_data(typ), light_ckpt_new[typ],
+      typ == State_Type ? light_ckpt_new_scalars : unused, float_scalars,
+      Factory());
+    if (state[typ].hasOldData()) {
+      store_light_checkpoint(
+        get_old_data(typ), light_ckpt_old[typ],
+        typ == State_Type ? light_ckpt_old_scalars : unused, float_scalars,
+        Factory());
+    } else {
+      light_ckpt_old[typ].clear();
+    }
+  }
+
+  light_ckpt_time = state[State_Type].curTime();
+  light_ckpt_prev_time = state[State_Type].prevTime();
+  light_ckpt_dt = parent->dtLevel(level);
+  light_ckpt_dt_min = parent->dtMin(level);
+  light_ckpt_level_steps = parent->levelSteps(level);
+  light_ckpt_step = parent->levelSteps(0);
+
+  if (verbose > 1) {
+    amrex::Print() << "Lightweight checkpoint at level " << level
+                   << ", step " << light_ckpt_step
+                   << ", time = " << light_ckpt_time << std::endl;
+  }
+}
+
+bool
+PeleC::validLightCheckpoint(const int step) const
+{
+  // The grids may have changed since the checkpoint was taken.
+  if ((light_ckpt_step < 0) || (light_ckpt_step != step)) {
+    return false;
+  }
+  for (int typ = 0; typ < desc_lst.size(); ++typ) {
+    if (
+      (light_ckpt_new[typ].boxArray() != grids) ||
+      (light_ckpt_new[typ].DistributionMap() != dmap)) {
+      return false;
+    }
+    if (
+      state[typ].hasOldData() &&
+      ((light_ckpt_old[typ].boxArray() != grids) ||
+       (light_ckpt_old[typ].DistributionMap() != dmap))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool
+PeleC::restoreLightCheckpoint()
+{
+  BL_PROFILE("PeleC::restoreLightCheckpoint()");
+
+  if (!validLightCheckpoint(light_ckpt_step)) {
+    return false;
+  }
+
+  for (int typ = 0; typ < desc_lst.size(); ++typ) {
+    load_light_checkpoint(
+      get_new_data(typ), light_ckpt_new[typ], light_ckpt_new_scalars);
+    if (state[typ].hasOldData()) {
+      load_light_checkpoint(
+        get_old_data(typ), light_ckpt_old[typ], light_ckpt_old_scalars);
+    }
+    state[typ].setOldTimeLevel(light_ckpt_prev_time);
+    state[typ].setNewTimeLevel(light_ckpt_time);
+  }
+
+  // The dt that triggered the failure would stop the restarted run again.
+  // With the dt estimate restored too, the next step gets the dt it had
+  // after the checkpoint.
+  parent->setDtLevel(light_ckpt_dt, level);
+  amrex::Vector<amrex::Real> dt_min(parent->maxLevel() + 1);
+  for (int lev = 0; lev <= parent->maxLevel(); ++lev) {
+    dt_min[lev] = parent->dtMin(lev);
+  }
+  dt_min[level] = light_ckpt_dt_min;
+  parent->setDtMin(dt_min);
+  parent->setLevelSteps(level, light_ckpt_level_steps);
+
+  if (verbose) {
+    amrex::Print() << "Restored level " << level
+                   << " from lightweight checkpoint at step "
+                   << light_ckpt_step << ", time = " << light_ckpt_time
+                   << std::endl;
+  }
+
+  return true;
+}
+
 void
 PeleC::setPlotVariables()
 {
@@ -756,6 +936,7 @@ void
 PeleC::writePlotFile(
   const std::string& dir, std::ostream& os, amrex::VisMF::How how)
 {
+  TelemetryTimer tel(tel_io);
   // The list of indices of State to write to plotfile.
   // first component of pair is state_type,
   // second component of pair is component # within the state_type
@@ -989,6 +1170,7 @@ void
 PeleC::writeSmallPlotFile(
   const std::string& dir, std::ostream& os, amrex::VisMF::How how)
 {
+  TelemetryTimer tel(tel_io);
   // The list of indices of State to write to plotfile.
   // first component of pair is state_type,
   // second component of pair is component # within the state_type
@@ -0,0 +1,462 @@
+#include <AMReX_MLMG.H>
+
+#include "PeleC.H"
+#include "IndexDefines.H"
+#include "Diffterm.H"
+#include "Utilities.H"
+
+// Linearly implicit Euler step of the diffusion terms.
+//
+// After the hydrodynamic step, S_new = U* is advanced over dt by the
+// diffusion terms alone. With the explicit diffusion rate D(U*) and an
+// approximate diffusion Jacobian J whose coefficients are frozen at U*,
+//
+//    U^{n+1} = U* + dt (I - dt J)^-1 D(U*).
+//
+// For each component group this is a solve, in the primitive variable of the
+// group, of
+//
+//    a phi - dt div(b grad(phi)) = D,    U^{n+1} = U* + dt a phi,
+//
+// with (a, b) = (rho, rho D_k) for the species, (rho cv, lambda) for the
+// temperature, and for the velocity component i (rho, mu) on the faces normal
+// to the other directions and (rho, 4/3 mu + xi) on the faces normal to
+// direction i. Then a phi = D - div(G), where G = -dt b grad(phi) are face
+// fluxes, so the step is the explicit diffusive fluxes plus the correction
+// fluxes G. The species corrections are made to sum to zero as in the
+// explicit fluxes, and the energy correction carries the species enthalpies
+// and the work of the momentum correction. Both sets of fluxes go into the
+// flux registers, so reflux stays conservative. At the coarse-fine boundary,
+// phi takes the values of the coarser level's solution, and at the domain
+// boundaries it vanishes where the state has a Dirichlet or odd reflection
+// condition and has zero gradient elsewhere.
+//
+// Steady states are unchanged, and the diffusive modes with dt |J| >> 1 are
+// damped instead of amplified, so the timestep is set by the hydrodynamic
+// CFL. The splitting and the implicit Euler step are first order in time.
+
+namespace {
+enum implicit_diff_groups {
+  idiff_spec = 0,
+  idiff_ener,
+  idiff_mom,
+  num_idiff_groups
+};
+
+// Components of implicit_diff_data
+enum implicit_diff_data_comps {
+  idd_rho = 0,
+  idd_rhocv,
+  idd_vel,
+  idd_spec = idd_vel + AMREX_SPACEDIM,
+  idd_enth = idd_spec + NUM_SPECIES,
+  idd_ncomp = idd_enth + NUM_SPECIES
+};
+
+// Domain boundary condition of the increment of a state component
+amrex::LinOpBCType
+implicit_diff_bc(const int bc, const bool periodic)
+{
+  if (periodic) {
+    return amrex::LinOpBCType::Periodic;
+  }
+  if ((bc == amrex::BCType::ext_dir) || (bc == amrex::BCType::reflect_odd)) {
+    return amrex::LinOpBCType::Dirichlet;
+  }
+  return amrex::LinOpBCType::Neumann;
+}
+} // namespace
+
+void
+PeleC::build_implicit_diffusion(amrex::Real time, amrex::Real dt)
+{
+  BL_PROFILE("PeleC::build_implicit_diffusion()");
+
+  if (eb_in_domain) {
+    amrex::Abort("implicit_diffusion is not yet available with EB");
+  }
+
+  const int nCompTr = dComp_lambda + 1;
+  const int ngrow = 1;
+  amrex::MultiFab S(grids, dmap, NVAR, ngrow, amrex::MFInfo(), Factory());
+  {
+    TelemetryTimer tel(tel_fillpatch);
+    FillPatch(*this, S, ngrow, time, State_Type, 0, NVAR);
+  }
+  TelemetryTimer tel(tel_diffusion);
+
+  amrex::MultiFab coeff_cc(
+    grids, dmap, nCompTr, ngrow, amrex::MFInfo(), Factory());
+  implicit_diff_data.define(
+    grids, dmap, idd_ncomp, ngrow, amrex::MFInfo(), Factory());
+
+#ifdef _OPENMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+  for (amrex::MFIter mfi(S, amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+    const amrex::Box gbox = mfi.growntilebox(ngrow);
+
+    int nqaux = NQAUX > 0 ? NQAUX : 1;
+    amrex::FArrayBox q(gbox, QVAR);
+    amrex::FArrayBox qaux(gbox, nqaux);
+    amrex::Elixir qeli = q.elixir();
+    amrex::Elixir qauxeli = qaux.elixir();
+    auto const& sar = S.const_array(mfi);
+    auto const& qar = q.array();
+    auto const& qauxar = qaux.array();
+    {
+      BL_PROFILE("PeleC::ctoprim()");
+      PassMap const* lpmap = d_pass_map;
+      const int captured_clean_massfrac = clean_massfrac;
+      amrex::ParallelFor(
+        gbox, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+          pc_ctoprim(
+            i, j, k, sar, qar, qauxar, *lpmap, captured_clean_massfrac);
+        });
+    }
+
+    {
+      auto const& qar_yin = q.array(QFS);
+      auto const& qar_Tin = q.array(QTEMP);
+      auto const& qar_rhoin = q.array(QRHO);
+      auto const& coe_rhoD = coeff_cc.array(mfi, dComp_rhoD);
+      auto const& coe_mu = coeff_cc.array(mfi, dComp_mu);
+      auto const& coe_xi = coeff_cc.array(mfi, dComp_xi);
+      auto const& coe_lambda = coeff_cc.array(mfi, dComp_lambda);
+      BL_PROFILE("PeleC::get_transport_coeffs()");
+      pele::physics::transport::TransParm const* ltransparm =
+        pele::physics::transport::trans_parm_g;
+      pc_get_transport_coeffs(
+        gbox, qar_yin, qar_Tin, qar_rhoin, coe_rhoD, coe_mu, coe_xi,
+        coe_lambda, ltransparm, transport_table);
+    }
+
+    auto const& dat = implicit_diff_data.array(mfi);
+    amrex::ParallelFor(
+      gbox, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+        amrex::Real massfrac[NUM_SPECIES];
+        for (int n = 0; n < NUM_SPECIES; n++) {
+          massfrac[n] = qar(i, j, k, QFS + n);
+        }
+        const amrex::Real rho = qar(i, j, k, QRHO);
+        const amrex::Real T = qar(i, j, k, QTEMP);
+        amrex::Real cv = 0.0;
+        amrex::Real hi[NUM_SPECIES] = {0.0};
+        auto eos = pele::physics::PhysicsType::eos();
+        eos.RTY2Cv(rho, T, massfrac, cv);
+#ifndef PELEC_USE_SRK
+        eos.T2Hi(T, hi);
+#else
+        eos.RTY2Hi(rho, T, massfrac, hi);
+#endif
+        dat(i, j, k, idd_rho) = rho;
+        dat(i, j, k, idd_rhocv) = rho * cv;
+        AMREX_D_TERM(dat(i, j, k, idd_vel) = qar(i, j, k, QU);
+                     , dat(i, j, k, idd_vel + 1) = qar(i, j, k, QV);
+                     , dat(i, j, k, idd_vel + 2) = qar(i, j, k, QW););
+        for (int n = 0; n < NUM_SPECIES; n++) {
+          dat(i, j, k, idd_spec + n) = massfrac[n];
+          dat(i, j, k, idd_enth + n) = hi[n];
+        }
+      });
+  }
+
+  const int ncomps[num_idiff_groups] = {NUM_SPECIES, 1, AMREX_SPACEDIM};
+  const int acomps[num_idiff_groups] = {idd_rho, idd_rhocv, idd_rho};
+  const bool active[num_idiff_groups] = {
+    diffuse_spec != 0, diffuse_temp != 0 || diffuse_enth != 0,
+    diffuse_vel != 0};
+
+  amrex::LPInfo info;
+  for (int g = 0; g < num_idiff_groups; g++) {
+    if (!active[g]) {
+      implicit_diff_op[g].reset();
+      implicit_diff_phi[g].clear();
+      continue;
+    }
+    const int ncomp = ncomps[g];
+
+    // Domain boundary conditions of each component, from those of the state
+    amrex::Vector<amrex::Array<amrex::LinOpBCType, AMREX_SPACEDIM>> lobc(
+      ncomp);
+    amrex::Vector<amrex::Array<amrex::LinOpBCType, AMREX_SPACEDIM>> hibc(
+      ncomp);
+    for (int n = 0; n < ncomp; n++) {
+      const int scomp =
+        (g == idiff_spec) ? UFS + n : ((g == idiff_ener) ? UTEMP : UMX + n);
+      const amrex::BCRec& bc = desc_lst[State_Type].getBC(scomp);
+      for (int dir = 0; dir < AMREX_SPACEDIM; dir++) {
+        lobc[n][dir] = implicit_diff_bc(bc.lo(dir), geom.isPeriodic(dir));
+        hibc[n][dir] = implicit_diff_bc(bc.hi(dir), geom.isPeriodic(dir));
+      }
+    }
+
+    // Face coefficients, arithmetic averages of the cell values
+    amrex::Array<amrex::MultiFab, AMREX_SPACEDIM> bcoef;
+    for (int dir = 0; dir < AMREX_SPACEDIM; dir++) {
+      bcoef[dir].define(
+        amrex::convert(grids, amrex::IntVect::TheDimensionVector(dir)), dmap,
+        ncomp, 0);
+#ifdef _OPENMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+      for (amrex::MFIter mfi(bcoef[dir], amrex::TilingIfNotGPU());
+           mfi.isValid(); ++mfi) {
+        const amrex::Box ebox = mfi.tilebox();
+        auto const& b = bcoef[dir].array(mfi);
+        auto const& coe = coeff_cc.const_array(mfi);
+        const amrex::IntVect iv = amrex::IntVect::TheDimensionVector(dir);
+        amrex::ParallelFor(
+          ebox, ncomp,
+          [=] AMREX_GPU_DEVICE(int i, int j, int k, int n) noexcept {
+            const amrex::IntVect cell(AMREX_D_DECL(i, j, k));
+            amrex::Real bl;
+            amrex::Real br;
+            if (g == idiff_spec) {
+              bl = coe(cell - iv, dComp_rhoD + n);
+              br = coe(cell, dComp_rhoD + n);
+            } else if (g == idiff_ener) {
+              bl = coe(cell - iv, dComp_lambda);
+              br = coe(cell, dComp_lambda);
+            } else if (n == dir) {
+              bl = 4.0 / 3.0 * coe(cell - iv, dComp_mu) +
+                   coe(cell - iv, dComp_xi);
+              br = 4.0 / 3.0 * coe(cell, dComp_mu) + coe(cell, dComp_xi);
+            } else {
+              bl = coe(cell - iv, dComp_mu);
+              br = coe(cell, dComp_mu);
+            }
+            b(i, j, k, n) = 0.5 * (bl + br);
+          });
+      }
+    }
+
+    implicit_diff_op[g] = std::make_unique<amrex::MLABecLaplacian>(
+      amrex::Vector<amrex::Geometry>{geom},
+      amrex::Vector<amrex::BoxArray>{grids},
+      amrex::Vector<amrex::DistributionMapping>{dmap}, info,
+      amrex::Vector<amrex::FabFactory<amrex::FArrayBox> const*>{}, ncomp);
+    auto& op = *implicit_diff_op[g];
+    op.setMaxOrder(2);
+    op.setDomainBC(lobc, hibc);
+    // The coarser level has already taken its step, and its solution gives
+    // the values at the coarse-fine boundary
+    if (level > 0) {
+      const amrex::MultiFab& crse_phi =
+        getLevel(level - 1).implicit_diff_phi[g];
+      AMREX_ALWAYS_ASSERT(crse_phi.ok() && crse_phi.nComp() == ncomp);
+      op.setCoarseFineBC(&crse_phi, parent->refRatio(level - 1)[0]);
+    }
+    op.setLevelBC(0, nullptr);
+    op.setScalars(1.0, dt);
+    amrex::MultiFab acoef(implicit_diff_data, amrex::make_alias, acomps[g], 1);
+    op.setACoeffs(0, acoef);
+    op.setBCoeffs(0, amrex::GetArrOfConstPtrs(bcoef));
+  }
+}
+
+void
+PeleC::implicit_diffusion_step(amrex::Real time, amrex::Real dt)
+{
+  BL_PROFILE("PeleC::implicit_diffusion_step()");
+
+  const amrex::Real strt_time = amrex::ParallelDescriptor::second();
+  int niters[num_idiff_groups] = {0};
+
+  amrex::MultiFab& S_new = get_new_data(State_Type);
+
+  // Explicit diffusion rate at U*, whose fluxes enter the flux registers
+  amrex::MultiFab Drate(grids, dmap, NVAR, 0, amrex::MFInfo(), Factory());
+  fillAndGetMOLSrcTerm(time + dt, Drate, time, dt, 1.0, diffusion_terms);
+
+  build_implicit_diffusion(time + dt, dt);
+
+  TelemetryTimer tel(tel_diffusion);
+
+  // Correction fluxes of all the conserved components
+  amrex::Array<amrex::MultiFab, AMREX_SPACEDIM> cflux;
+  for (int dir = 0; dir < AMREX_SPACEDIM; dir++) {
+    cflux[dir].define(
+      amrex::convert(grids, amrex::IntVect::TheDimensionVector(dir)), dmap,
+      NVAR, 0);
+    cflux[dir].setVal(0.0);
+  }
+
+  const int ncomps[num_idiff_groups] = {NUM_SPECIES, 1, AMREX_SPACEDIM};
+  const int rcomps[num_idiff_groups] = {UFS, UEDEN, UMX};
+  const int acomps[num_idiff_groups] = {idd_rho, idd_rhocv, idd_rho};
+
+  for (int g = 0; g < num_idiff_groups; g++) {
+    if (!implicit_diff_op[g]) {
+      continue;
+    }
+    const int ncomp = ncomps[g];
+    const int rcomp = rcomps[g];
+    const int acomp = acomps[g];
+
+    // Explicit rate of the group, with the kinetic energy of the momentum
+    // rate removed from the energy rate
+    amrex::MultiFab rhs(grids, dmap, ncomp, 0, amrex::MFInfo(), Factory());
+    amrex::MultiFab& phi = implicit_diff_phi[g];
+    phi.define(grids, dmap, ncomp, 1, amrex::MFInfo(), Factory());
+    phi.setVal(0.0);
+#ifdef _OPENMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+    for (amrex::MFIter mfi(rhs, amrex::TilingIfNotGPU()); mfi.isValid();
+         ++mfi) {
+      const amrex::Box bx = mfi.tilebox();
+      auto const& r = rhs.array(mfi);
+      auto const& p = phi.array(mfi);
+      auto const& d = Drate.const_array(mfi);
+      auto const& dat = implicit_diff_data.const_array(mfi);
+      const bool thermal = (g == idiff_ener);
+      amrex::ParallelFor(
+        bx, ncomp, [=] AMREX_GPU_DEVICE(int i, int j, int k, int n) noexcept {
+          amrex::Real rate = d(i, j, k, rcomp + n);
+          if (thermal) {
+            for (int dir = 0; dir < AMREX_SPACEDIM; dir++) {
+              rate -= dat(i, j, k, idd_vel + dir) * d(i, j, k, UMX + dir);
+            }
+          }
+          r(i, j, k, n) = rate;
+          // Initial guess from the explicit rate
+          p(i, j, k, n) = rate / dat(i, j, k, acomp);
+        });
+    }
+
+    amrex::MLMG mlmg(*implicit_diff_op[g]);
+    mlmg.setMaxIter(implicit_diffusion_maxiter);
+    mlmg.setVerbose(0);
+    mlmg.solve(
+      {&phi}, {&rhs}, implicit_diffusion_rtol, implicit_diffusion_atol);
+    niters[g] = mlmg.getNumIters();
+
+    // G = -dt b grad(phi)
+    amrex::Array<amrex::MultiFab, AMREX_SPACEDIM> gflux;
+    for (int dir = 0; dir < AMREX_SPACEDIM; dir++) {
+      gflux[dir].define(cflux[dir].boxArray(), dmap, ncomp, 0);
+    }
+    mlmg.getFluxes({amrex::GetArrOfPtrs(gflux)});
+    for (int dir = 0; dir < AMREX_SPACEDIM; dir++) {
+      amrex::MultiFab::Copy(cflux[dir], gflux[dir], 0, rcomp, ncomp, 0);
+    }
+
+    phi.FillBoundary(geom.periodicity());
+  }
+
+  // Make the species corrections sum to zero, add the enthalpy they carry and
+  // the work of the momentum correction to the energy correction, and scale
+  // by the face areas
+  const bool spec_active = static_cast<bool>(implicit_diff_op[idiff_spec]);
+  const bool mom_active = static_cast<bool>(implicit_diff_op[idiff_mom]);
+  for (int dir = 0; dir < AMREX_SPACEDIM; dir++) {
+#ifdef _OPENMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+    for (amrex::MFIter mfi(cflux[dir], amrex::TilingIfNotGPU()); mfi.isValid();
+         ++mfi) {
+      const amrex::Box ebox = mfi.tilebox();
+      auto const& f = cflux[dir].array(mfi);
+      auto const& dat = implicit_diff_data.const_array(mfi);
+      auto const& ar = area[dir].const_array(mfi);
+      const amrex::IntVect iv = amrex::IntVect::TheDimensionVector(dir);
+      amrex::ParallelFor(
+        ebox, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+          const amrex::IntVect cell(AMREX_D_DECL(i, j, k));
+          if (spec_active) {
+            amrex::Real fsum = 0.0;
+            for (int n = 0; n < NUM_SPECIES; n++) {
+              fsum += f(cell, UFS + n);
+            }
+            for (int n = 0; n < NUM_SPECIES; n++) {
+              const amrex::Real Yface =
+                0.5 * (dat(cell - iv, idd_spec + n) + dat(cell, idd_spec + n));
+              const amrex::Real hface =
+                0.5 * (dat(cell - iv, idd_enth + n) + dat(cell, idd_enth + n));
+              f(cell, UFS + n) -= Yface * fsum;
+              f(cell, UEDEN) += hface * f(cell, UFS + n);
+            }
+          }
+          if (mom_active) {
+            for (int n = 0; n < AMREX_SPACEDIM; n++) {
+              const amrex::Real uface =
+                0.5 * (dat(cell - iv, idd_vel + n) + dat(cell, idd_vel + n));
+              f(cell, UEDEN) += uface * f(cell, UMX + n);
+            }
+          }
+          for (int n = 0; n < NVAR; n++) {
+            f(cell, n) *= ar(cell);
+          }
+        });
+    }
+  }
+
+  // U^{n+1} = U* + dt (D - div(G))
+  amrex::MultiFab Crate(grids, dmap, NVAR, 0, amrex::MFInfo(), Factory());
+#ifdef _OPENMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+  for (amrex::MFIter mfi(Crate, amrex::TilingIfNotGPU()); mfi.isValid();
+       ++mfi) {
+    const amrex::Box bx = mfi.tilebox();
+    auto const& c = Crate.array(mfi);
+    auto const& vol = volume.const_array(mfi);
+    AMREX_D_TERM(auto const& fx = cflux[0].const_array(mfi);
+                 , auto const& fy = cflux[1].const_array(mfi);
+                 , auto const& fz = cflux[2].const_array(mfi););
+    amrex::ParallelFor(
+      bx, NVAR, [=] AMREX_GPU_DEVICE(int i, int j, int k, int n) noexcept {
+        pc_flux_div(i, j, k, n, AMREX_D_DECL(fx, fy, fz), vol, c);
+      });
+  }
+  amrex::MultiFab::Add(Drate, Crate, 0, 0, NVAR, 0);
+  amrex::MultiFab::Saxpy(S_new, dt, Drate, 0, 0, NVAR, 0);
+  computeTemp(S_new, 0);
+
+  // The correction fluxes are not in the registers yet
+  if (do_reflux) {
+#ifdef AMREX_USE_GPU
+    auto device = amrex::RunOn::Gpu;
+#else
+    auto device = amrex::RunOn::Cpu;
+#endif
+    const amrex::Real* dx = geom.CellSize();
+    amrex::Real dx1 = dx[0];
+    for (int dir = 1; dir < AMREX_SPACEDIM; ++dir) {
+      dx1 *= dx[dir];
+    }
+    const amrex::Real dxD[AMREX_SPACEDIM] = {AMREX_D_DECL(dx1, dx1, dx1)};
+    for (amrex::MFIter mfi(S_new); mfi.isValid(); ++mfi) {
+      if (level < parent->finestLevel()) {
+        getFluxReg(level + 1).CrseAdd(
+          mfi,
+          {{AMREX_D_DECL(&cflux[0][mfi], &cflux[1][mfi], &cflux[2][mfi])}},
+          dxD, dt, device);
+      }
+      if (level > 0) {
+        getFluxReg(level).FineAdd(
+          mfi,
+          {{AMREX_D_DECL(&cflux[0][mfi], &cflux[1][mfi], &cflux[2][mfi])}},
+          dxD, dt, device);
+      }
+    }
+  }
+
+  if (verbose) {
+    amrex::Real run_time = amrex::ParallelDescriptor::second() - strt_time;
+    const int IOProc = amrex::ParallelDescriptor::IOProcessorNumber();
+#ifdef AMREX_LAZY
+    Lazy::QueueReduction([=]() mutable {
+#endif
+      amrex::ParallelDescriptor::ReduceRealMax(run_time, IOProc);
+      amrex::Print() << "... Implicit diffusion on level " << level
+                     << ": MLMG iterations (species, energy, momentum) = ("
+                     << niters[idiff_spec] << ", " << niters[idiff_ener]
+                     << ", " << niters[idiff_mom] << "), time = " << run_time
+                     << " s" << std::endl;
+#ifdef AMREX_LAZY
+    });
+#endif
+  }
+}
@@ -122,6 +122,13 @@ PeleC::getLESTerm(
     getDynamicSmagorinskyLESTerm(time, dt, LESTerm, flux_factor);
     break;
 
+  case 2:
+  case 3:
+  case 4:
+    // WALE, Vreman and Sigma use the same local stencil as Smagorinsky
+    getSmagorinskyLESTerm(time, dt, LESTerm, flux_factor);
+    break;
+
   default:
     amrex::Error("Invalid les_model number.");
     break;
@@ -171,7 +178,8 @@ PeleC::getLESTerm(
   }
 }
 
-// Calculate the LES term using the Smagorinsky SFS model
+// Calculate the LES term using the Smagorinsky SFS model, or one of the
+// algebraic models (WALE, Vreman, Sigma) that share its stencil
 void
 PeleC::getSmagorinskyLESTerm(
   amrex::Real time,
@@ -192,7 +200,10 @@ PeleC::getSmagorinskyLESTerm(
   const amrex::Real* dxDp = &(dxD[0]);
 
   amrex::MultiFab S(grids, dmap, NVAR, ngrow);
-  FillPatch(*this, S, ngrow, time, State_Type, 0, NVAR); // FIXME: time+dt?
+  {
+    TelemetryTimer tel(tel_fillpatch);
+    FillPatch(*this, S, ngrow, time, State_Type, 0, NVAR); // FIXME: time+dt?
+  }
 
   // Fetch some gpu arrays
   prefetchToDevice(S);
@@ -226,6 +237,7 @@ PeleC::getSmagorinskyLESTerm(
       }
 #endif
 
+      const amrex::Real wt = amrex::ParallelDescriptor::second();
       auto const& s = S.array(mfi);
       int nqaux = NQAUX > 0 ? NQAUX : 1;
       amrex::FArrayBox q(gbox, QVAR);
@@ -302,11 +314,12 @@ PeleC::getSmagorinskyLESTerm(
           amrex::Real Cs_local = PeleC::Cs;
           amrex::Real CI_local = PeleC::CI;
           amrex::Real PrT_local = PeleC::PrT;
+          const int les_model_local = PeleC::les_model;
           amrex::ParallelFor(
             eboxes[dir], [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
               pc_smagorinsky_sfs_term(
-                i, j, k, q_ar, tanders[dir], a[dir], dx[dir], dir, Cs_local,
-                CI_local, PrT_local, flx[dir]);
+                i, j, k, q_ar, tanders[dir], a[dir], dx[dir], dir,
+                les_model_local, Cs_local, CI_local, PrT_local, flx[dir]);
             });
         }
       }
@@ -352,6 +365,8 @@ PeleC::getSmagorinskyLESTerm(
             dt, device);
         }
       }
+
+      add_box_cost(cost_les, mfi, wt);
     } // End of MFIter scope
   }   // End of OMP scope
 #else
@@ -375,12 +390,16 @@ PeleC::getDynamicSmagorinskyLESTerm(
     N + 0**                           (ebox) |----->         flux_ec, coeff_ec, alphaij_ec, alpha_ec, flux_T_ec
     N + 1                            (g4box) |------>        filtered_coeff_cc [= LES_Coeffs]
     N + 1 + nGrowC                   (g3box) |-------->      coeff_cc, filtered_(K, RUT, alphaij, alpha, flux_T)
-    N + 1 + nGrowC + nGrowD          (g2box) |---------->    filtered_(S, Q, Qaux)
+    N + 1 + nGrowC + nGrowD          (g2box) |---------->    filtered_(S, Q)
     N + 1 + nGrowC + nGrowT          (g1box) |----------->   K, RUT, alphaij, alpha, flux_T
     N + 1 + nGrowC + nGrowT + nGrowD (g0box) |-------------> S, Q, Qaux
        |----------------------------|
        This is the number of grow cells on each side
 
+    On steps where the coefficients are reused (les_dynamic_update_int > 1),
+    LES_Coeffs is kept from the last update and only N + 1 + nGrowD grow
+    cells of S are needed, with K, RUT, alphaij, alpha, flux_T on g4box.
+
     where
     nGrowD = number of grow cells necessary for the diffusion operator
     nGrowC = number of grow cells necessary for filtering the Smagorinsky coefficients
@@ -408,12 +427,27 @@ PeleC::getDynamicSmagorinskyLESTerm(
     {AMREX_D_DECL(dx1, dx1, dx1)}};
   const amrex::Real* dxDp = &(dxD[0]);
 
-  // 1. Get state variable data
-  amrex::MultiFab S(grids, dmap, NVAR, nGrowD + nGrowC + nGrowT + 1);
-  FillPatch(
-    *this, S, nGrowD + nGrowC + nGrowT + 1, time, State_Type, 0,
-    NVAR); // FIXME: time+dt?
-  LES_Coeffs.setVal(0.0);
+  // The coefficients are only recomputed every les_dynamic_update_int steps.
+  // In between, only the quantities at the grid filter level are needed.
+  const bool update_coeffs =
+    !les_coeffs_valid ||
+    (parent->levelSteps(level) % les_dynamic_update_int == 0);
+  const int nGrowS =
+    update_coeffs ? nGrowD + nGrowC + nGrowT + 1 : nGrowD + 1;
+
+  // 1. Get state variable data. The buffer has the ghost cells of a
+  // coefficient update on every step, so that it is not reallocated in
+  // between.
+  amrex::MultiFab& S = buffers.get(
+    buf_les_state, grids, dmap, NVAR, nGrowD + nGrowC + nGrowT + 1,
+    &Factory());
+  {
+    TelemetryTimer tel(tel_fillpatch);
+    FillPatch(*this, S, nGrowS, time, State_Type, 0, NVAR); // FIXME: time+dt?
+  }
+  if (update_coeffs) {
+    LES_Coeffs.setVal(0.0);
+  }
 
   // Fetch some gpu arrays
   prefetchToDevice(S);
@@ -432,7 +466,7 @@ PeleC::getDynamicSmagorinskyLESTerm(
   {
     for (amrex::MFIter mfi(S, amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi) {
       const amrex::Box vbox = mfi.tilebox();
-      const amrex::Box g0box = amrex::grow(vbox, nGrowD + nGrowC + nGrowT + 1);
+      const amrex::Box g0box = amrex::grow(vbox, nGrowS);
       const amrex::Box g1box = amrex::grow(vbox, nGrowC + nGrowT + 1);
       const amrex::Box g2box = amrex::grow(vbox, nGrowD + nGrowC + 1);
       const amrex::Box g3box = amrex::grow(vbox, nGrowC + 1);
@@ -440,6 +474,9 @@ PeleC::getDynamicSmagorinskyLESTerm(
       const amrex::Box cbox = amrex::grow(vbox, 0);
       // const amrex::Box& dbox = geom.Domain();
 
+      // The derived quantities are only needed on g1box to be test filtered
+      const amrex::Box dqbox = update_coeffs ? g1box : g4box;
+
 #ifdef PELEC_USE_EB
       const auto& flag_fab = flags[mfi];
       amrex::FabType typ = flag_fab.getType(cbox);
@@ -451,6 +488,7 @@ PeleC::getDynamicSmagorinskyLESTerm(
       }
 #endif
 
+      const amrex::Real wt = amrex::ParallelDescriptor::second();
       auto const& s = S.array(mfi);
       int nqaux = NQAUX > 0 ? NQAUX : 1;
       amrex::FArrayBox q(g0box, QVAR);
@@ -483,11 +521,11 @@ PeleC::getDynamicSmagorinskyLESTerm(
       amrex::FArrayBox alphaij;
       amrex::FArrayBox alpha;
       amrex::FArrayBox flux_T;
-      K.resize(g1box, upper_triangle_n);
-      RUT.resize(g1box, AMREX_SPACEDIM);
-      alphaij.resize(g1box, AMREX_SPACEDIM * AMREX_SPACEDIM);
-      alpha.resize(g1box, 1);
-      flux_T.resize(g1box, AMREX_SPACEDIM);
+      K.resize(dqbox, upper_triangle_n);
+      RUT.resize(dqbox, AMREX_SPACEDIM);
+      alphaij.resize(dqbox, AMREX_SPACEDIM * AMREX_SPACEDIM);
+      alpha.resize(dqbox, 1);
+      flux_T.resize(dqbox, AMREX_SPACEDIM);
       amrex::Elixir K_eli = K.elixir();
       amrex::Elixir RUT_eli = RUT.elixir();
       amrex::Elixir alphaij_eli = alphaij.elixir();
@@ -503,92 +541,90 @@ PeleC::getDynamicSmagorinskyLESTerm(
         const int les_filter_fgr_local = PeleC::les_filter_fgr;
         BL_PROFILE("PeleC::pc_smagorinsky_sfs_term()");
         amrex::ParallelFor(
-          g1box, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+          dqbox, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
             pc_dynamic_smagorinsky_quantities(
               i, j, k, q_ar, les_filter_fgr_local, dx, K_ar, RUT_ar, alphaij_ar,
               alpha_ar, flux_T_ar);
           });
       }
 
-      // 3. Filter the state variables and the derived quantities at the
-      // test filter level - still at cell centers
-      amrex::FArrayBox filtered_S;
-      amrex::FArrayBox filtered_Q;
-      amrex::FArrayBox filtered_Qaux;
-      amrex::FArrayBox filtered_K;
-      amrex::FArrayBox filtered_RUT;
-      amrex::FArrayBox filtered_alphaij;
-      amrex::FArrayBox filtered_alpha;
-      amrex::FArrayBox filtered_flux_T;
-      filtered_S.resize(g2box, NVAR);
-      filtered_Q.resize(g2box, QVAR);
-      filtered_Qaux.resize(g2box, NQAUX > 0 ? NQAUX : 1);
-      filtered_K.resize(g3box, upper_triangle_n);
-      filtered_RUT.resize(g3box, AMREX_SPACEDIM);
-      filtered_alphaij.resize(g3box, AMREX_SPACEDIM * AMREX_SPACEDIM);
-      filtered_alpha.resize(g3box, 1);
-      filtered_flux_T.resize(g3box, AMREX_SPACEDIM);
-      amrex::Elixir filtered_S_eli = filtered_S.elixir();
-      amrex::Elixir filtered_Q_eli = filtered_Q.elixir();
-      amrex::Elixir filtered_Qaux_eli = filtered_Qaux.elixir();
-      amrex::Elixir filtered_K_eli = filtered_K.elixir();
-      amrex::Elixir filtered_RUT_eli = filtered_RUT.elixir();
-      amrex::Elixir filtered_alphaij_eli = filtered_alphaij.elixir();
-      amrex::Elixir filtered_alpha_eli = filtered_alpha.elixir();
-      amrex::Elixir filtered_flux_T_eli = filtered_flux_T.elixir();
-
-      auto const& filtered_S_ar = filtered_S.array();
-      auto const& filtered_Q_ar = filtered_Q.array();
-      auto const& filtered_Qaux_ar = filtered_Qaux.array();
-
-      const amrex::FArrayBox& Sfab = S[mfi];
-      test_filter.apply_filter(g2box, Sfab, filtered_S);
-      {
-        BL_PROFILE("PeleC::ctoprim()");
-        const PassMap* lpmap = d_pass_map;
-        const int captured_clean_massfrac = clean_massfrac;
-        amrex::ParallelFor(
-          g2box, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-            pc_ctoprim(
-              i, j, k, filtered_S_ar, filtered_Q_ar, filtered_Qaux_ar, *lpmap,
-              captured_clean_massfrac);
-          });
-      }
-      test_filter.apply_filter(g3box, K, filtered_K);
-      test_filter.apply_filter(g3box, RUT, filtered_RUT);
-      test_filter.apply_filter(g3box, alphaij, filtered_alphaij);
-      test_filter.apply_filter(g3box, alpha, filtered_alpha);
-      test_filter.apply_filter(g3box, flux_T, filtered_flux_T);
-
-      // 4. Calculate the dynamic Smagorinsky coefficients - still at cell
-      // centers
-      int do_harmonic = 1;
-      amrex::FArrayBox coeff_cc;
-      coeff_cc.resize(g3box, nCompC);
-      amrex::Elixir coeff_cc_eli = coeff_cc.elixir();
-      auto const& coeff_cc_ar = coeff_cc.array();
-      auto const& filtered_K_ar = filtered_K.array();
-      auto const& filtered_RUT_ar = filtered_RUT.array();
-      auto const& filtered_alphaij_ar = filtered_alphaij.array();
-      auto const& filtered_alpha_ar = filtered_alpha.array();
-      auto const& filtered_flux_T_ar = filtered_flux_T.array();
-      {
-        const int les_test_filter_fgr_local = PeleC::les_test_filter_fgr;
-        BL_PROFILE("PeleC::pc_dynamic_smagorinsky_coeffs()");
-        amrex::ParallelFor(
-          g3box, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-            pc_dynamic_smagorinsky_coeffs(
-              i, j, k, filtered_Q_ar, les_test_filter_fgr_local, dx,
-              filtered_K_ar, filtered_RUT_ar, filtered_alphaij_ar,
-              filtered_alpha_ar, filtered_flux_T_ar, coeff_cc_ar);
-          });
-      }
+      if (update_coeffs) {
+        // 3. Filter the state variables and the derived quantities at the
+        // test filter level - still at cell centers. Only the state
+        // components that set the density, velocity and temperature are
+        // filtered, and all derived quantities are filtered together.
+        amrex::FArrayBox filtered_S(g2box, NVAR);
+        amrex::FArrayBox filtered_Q(g2box, QVAR);
+        amrex::FArrayBox filtered_K(g3box, upper_triangle_n);
+        amrex::FArrayBox filtered_RUT(g3box, AMREX_SPACEDIM);
+        amrex::FArrayBox filtered_alphaij(
+          g3box, AMREX_SPACEDIM * AMREX_SPACEDIM);
+        amrex::FArrayBox filtered_alpha(g3box, 1);
+        amrex::FArrayBox filtered_flux_T(g3box, AMREX_SPACEDIM);
+        amrex::Elixir filtered_S_eli = filtered_S.elixir();
+        amrex::Elixir filtered_Q_eli = filtered_Q.elixir();
+        amrex::Elixir filtered_K_eli = filtered_K.elixir();
+        amrex::Elixir filtered_RUT_eli = filtered_RUT.elixir();
+        amrex::Elixir filtered_alphaij_eli = filtered_alphaij.elixir();
+        amrex::Elixir filtered_alpha_eli = filtered_alpha.elixir();
+        amrex::Elixir filtered_flux_T_eli = filtered_flux_T.elixir();
+
+        auto const& filtered_S_ar = filtered_S.array();
+        auto const& filtered_Q_ar = filtered_Q.array();
+
+        const auto& s_c = S.const_array(mfi);
+        const amrex::Vector<amrex::Array4<const amrex::Real>> s_in{
+          amrex::Array4<const amrex::Real>(s_c, URHO, UTEMP - URHO + 1),
+          amrex::Array4<const amrex::Real>(s_c, UFS, NUM_SPECIES)};
+        const amrex::Vector<amrex::Array4<amrex::Real>> s_out{
+          amrex::Array4<amrex::Real>(filtered_S_ar, URHO, UTEMP - URHO + 1),
+          amrex::Array4<amrex::Real>(filtered_S_ar, UFS, NUM_SPECIES)};
+        test_filter.apply_filter(g2box, s_in, s_out);
+        {
+          BL_PROFILE("PeleC::pc_dynamic_smagorinsky_filtered_prim()");
+          const int captured_clean_massfrac = clean_massfrac;
+          amrex::ParallelFor(
+            g2box, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+              pc_dynamic_smagorinsky_filtered_prim(
+                i, j, k, filtered_S_ar, filtered_Q_ar,
+                captured_clean_massfrac);
+            });
+        }
+        const amrex::Vector<const amrex::FArrayBox*> dq_in{
+          &K, &RUT, &alphaij, &alpha, &flux_T};
+        const amrex::Vector<amrex::FArrayBox*> dq_out{
+          &filtered_K, &filtered_RUT, &filtered_alphaij, &filtered_alpha,
+          &filtered_flux_T};
+        test_filter.apply_filter(g3box, dq_in, dq_out);
+
+        // 4. Calculate the dynamic Smagorinsky coefficients - still at cell
+        // centers
+        amrex::FArrayBox coeff_cc(g3box, nCompC);
+        amrex::Elixir coeff_cc_eli = coeff_cc.elixir();
+        auto const& coeff_cc_ar = coeff_cc.array();
+        auto const& filtered_K_ar = filtered_K.array();
+        auto const& filtered_RUT_ar = filtered_RUT.array();
+        auto const& filtered_alphaij_ar = filtered_alphaij.array();
+        auto const& filtered_alpha_ar = filtered_alpha.array();
+        auto const& filtered_flux_T_ar = filtered_flux_T.array();
+        {
+          const int les_test_filter_fgr_local = PeleC::les_test_filter_fgr;
+          BL_PROFILE("PeleC::pc_dynamic_smagorinsky_coeffs()");
+          amrex::ParallelFor(
+            g3box, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+              pc_dynamic_smagorinsky_coeffs(
+                i, j, k, filtered_Q_ar, les_test_filter_fgr_local, dx,
+                filtered_K_ar, filtered_RUT_ar, filtered_alphaij_ar,
+                filtered_alpha_ar, filtered_flux_T_ar, coeff_cc_ar);
+            });
+        }
 
-      // 5. Filter to smooth the dynamic coefficients - still at cell
-      // centers
+        // 5. Filter to smooth the dynamic coefficients - still at cell
+        // centers
+        coeff_filter.apply_filter(g4box, coeff_cc, LES_Coeffs[mfi]);
+      }
       auto const& LES_Coeffs_ar = LES_Coeffs[mfi].array();
-      coeff_filter.apply_filter(g4box, coeff_cc, LES_Coeffs[mfi]);
-
+      int do_harmonic = 1;
       // 6. Get the SFS term
 
       // First step: move everything needed to compute fluxes to ec (faces)
@@ -719,8 +755,14 @@ PeleC::getDynamicSmagorinskyLESTerm(
             dt, device);
         }
       }
+
+      add_box_cost(cost_les, mfi, wt);
     }
   }
+
+  if (update_coeffs) {
+    les_coeffs_valid = true;
+  }
 #else
   amrex::Abort("LES only implemented in 3D for now");
 #endif // End of AMREX_SPACEDIM == 3
@@ -0,0 +1,65 @@
+#include "LevelBuffers.H"
+
+amrex::Long LevelBuffers::n_allocated = 0;
+amrex::Long LevelBuffers::n_reused = 0;
+
+amrex::MultiFab&
+LevelBuffers::get(
+  const int buf,
+  const amrex::BoxArray& ba,
+  const amrex::DistributionMapping& dm,
+  const int ncomp,
+  const int ngrow,
+  const amrex::FabFactory<amrex::FArrayBox>* factory)
+{
+  AMREX_ASSERT(buf >= 0 && buf < num_level_buffers);
+
+  std::unique_ptr<amrex::MultiFab>& mf = m_mf[buf];
+  if (matches(mf, ba, dm, ncomp, ngrow)) {
+    n_reused++;
+    return *mf;
+  }
+
+  mf.reset();
+  if (factory != nullptr) {
+    mf = std::make_unique<amrex::MultiFab>(
+      ba, dm, ncomp, ngrow, amrex::MFInfo(), *factory);
+  } else {
+    mf = std::make_unique<amrex::MultiFab>(ba, dm, ncomp, ngrow);
+  }
+  n_allocated++;
+  return *mf;
+}
+
+amrex::iMultiFab&
+LevelBuffers::iget(
+  const int buf,
+  const amrex::BoxArray& ba,
+  const amrex::DistributionMapping& dm,
+  const int ncomp,
+  const int ngrow)
+{
+  AMREX_ASSERT(buf >= 0 && buf < num_level_buffers);
+
+  std::unique_ptr<amrex::iMultiFab>& imf = m_imf[buf];
+  if (matches(imf, ba, dm, ncomp, ngrow)) {
+    n_reused++;
+    return *imf;
+  }
+
+  imf.reset();
+  imf = std::make_unique<amrex::iMultiFab>(ba, dm, ncomp, ngrow);
+  n_allocated++;
+  return *imf;
+}
+
+void
+LevelBuffers::clear()
+{
+  for (auto& mf : m_mf) {
+    mf.reset();
+  }
+  for (auto& imf : m_imf) {
+    imf.reset();
+  }
+}
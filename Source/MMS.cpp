@@ -50,7 +50,7 @@ PeleC::fill_mms_source(
     if (verbose && amrex::ParallelDescriptor::IOProcessor()) {
       amrex::Print() << "... Reusing MMS source at time " << time << std::endl;
     }
-    amrex::MultiFab::Copy(mms_src, mms_source, 0, 0, NVAR, ng);
+    amrex::MultiFab::Copy(mms_src, mms_source, 0, 0, mms_src.nComp(), ng);
     return;
   }
 
@@ -61,7 +61,7 @@ PeleC::fill_mms_source(
 #ifdef PELEC_USE_MASA
 
   // Store the source for later reuse
-  mms_source.define(grids, dmap, NVAR, ng);
+  mms_source.define(grids, dmap, mms_src.nComp(), ng);
   mms_source.setVal(0.0);
 
   const amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> dx = geom.CellSizeArray();
@@ -94,6 +94,7 @@ PeleC::fill_mms_source(
       }
 #endif
 
+      const amrex::Real wt = amrex::ParallelDescriptor::second();
       auto const& s = S.array(mfi);
       auto const& src = mms_source.array(mfi);
 
@@ -114,10 +115,12 @@ PeleC::fill_mms_source(
                                     masa_eval_3d_exact_rho(x, y, z);
           }
         });
+
+      add_box_cost(cost_sources, mfi, wt);
     }
   }
 
-  amrex::MultiFab::Copy(mms_src, mms_source, 0, 0, NVAR, ng);
+  amrex::MultiFab::Copy(mms_src, mms_source, 0, 0, mms_src.nComp(), ng);
   mms_src_evaluated = true;
 
 #else
@@ -2,20 +2,41 @@
 #include "PPM.H"
 #include "WENO.H"
 
+// The reconstructions and flattening options of trace_ppm that get their own
+// kernel instantiation in every direction. Any other combination runs the
+// generic kernel, which branches on them in every cell.
+namespace {
+struct PPMSpecialization
+{
+  int recon;
+  int flattening;
+};
+
+constexpr PPMSpecialization ppm_specializations[] = {
+  {ppm_ppm, 1}, {ppm_ppm, 0}, {ppm_weno5z, 0}};
+
+constexpr int n_ppm_specializations =
+  sizeof(ppm_specializations) / sizeof(ppm_specializations[0]);
+static_assert(
+  n_ppm_specializations == 3,
+  "trace_ppm_dispatch must have a case for every specialization");
+} // namespace
+
+// Trace in direction idir with the reconstruction Recon and flattening
+// Flattening, or with the runtime rt_recon and rt_flattening for the generic
+// kernel (Recon == ppm_generic, Flattening < 0). Flattening only applies to
+// the PPM reconstruction.
+template <int idir, int Recon, int Flattening>
 void
-trace_ppm(
+trace_ppm_dir(
   const amrex::Box& bx,
-  const int idir,
   amrex::Array4<amrex::Real const> const& q_arr,
-  amrex::Array4<amrex::Real const> const& /*srcQ*/,
   amrex::Array4<amrex::Real> const& qm,
   amrex::Array4<amrex::Real> const& qp,
   const amrex::Box& vbx,
-  const amrex::Real dt,
-  const amrex::Real* dx,
-  const int use_flattening,
-  const int use_hybrid_weno,
-  const int weno_scheme)
+  const amrex::Real dtdx,
+  const int rt_recon,
+  const int rt_flattening)
 {
   // here, lo and hi are the range we loop over -- this can include ghost cells
   // vlo and vhi are the bounds of the valid box (no ghost cells)
@@ -34,7 +55,6 @@ trace_ppm(
   // for pure hydro, we will only consider:
   //    rho, u, v, w, ptot, rhoe_g, cc, h_g
   // amrex::Real hdt = 0.5 * dt;
-  amrex::Real dtdx = dt / dx[idir];
 
   // auto lo = bx.loVect3d();
   // auto hi = bx.hiVect3d();
@@ -63,23 +83,13 @@ trace_ppm(
   // jumps that are moving toward the interface to the reference
   // state to get the full state on that interface.
 
-  int QUN = 0;
-  int QUT = 0;
-  int QUTT = 0;
+  constexpr int QUN = idir == 0 ? QU : (idir == 1 ? QV : QW);
+  constexpr int QUT = idir == 0 ? QV : (idir == 1 ? QW : QU);
+  constexpr int QUTT = idir == 0 ? QW : (idir == 1 ? QU : QV);
 
-  if (idir == 0) {
-    QUN = QU;
-    QUT = QV;
-    QUTT = QW;
-  } else if (idir == 1) {
-    QUN = QV;
-    QUT = QW;
-    QUTT = QU;
-  } else if (idir == 2) {
-    QUN = QW;
-    QUT = QU;
-    QUTT = QV;
-  }
+  // Compile-time constants in the specialized kernels
+  const int recon = (Recon == ppm_generic) ? rt_recon : Recon;
+  const int flattening = (Flattening < 0) ? rt_flattening : Flattening;
 
   // Trace to left and right edges using upwind PPM
   amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
@@ -102,7 +112,7 @@ trace_ppm(
 
     amrex::Real flat = 1.0;
     // Calculate flattening in-place
-    if (use_flattening == 1) {
+    if (recon == ppm_ppm && flattening == 1) {
       for (int dir_flat = 0; dir_flat < AMREX_SPACEDIM; dir_flat++) {
         flat = amrex::min<amrex::Real>(flat, flatten(i, j, k, dir_flat, q_arr));
       }
@@ -112,7 +122,7 @@ trace_ppm(
     amrex::Real Im[QVAR][3];
 
     for (int n = 0; n < QVAR; n++) {
-      if (use_hybrid_weno && ((weno_scheme == 0) || (weno_scheme == 1))) {
+      if (recon == ppm_weno5js || recon == ppm_weno5z) {
 
         amrex::Real s_weno5[5];
         if (idir == 0) {
@@ -137,14 +147,14 @@ trace_ppm(
 
         amrex::Real sm = 0.0;
         amrex::Real sp = 0.0;
-        if (weno_scheme == 0) {
+        if (recon == ppm_weno5js) {
           weno_reconstruct_5js(s_weno5, sm, sp);
-        } else if (weno_scheme == 1) {
+        } else {
           weno_reconstruct_5z(s_weno5, sm, sp);
         }
         ppm_int_profile(sm, sp, s_weno5[2], un, cc, dtdx, Ip[n], Im[n]);
 
-      } else if (use_hybrid_weno && weno_scheme == 2) {
+      } else if (recon == ppm_weno7z) {
 
         amrex::Real s_weno7[7];
         if (idir == 0) {
@@ -178,7 +188,7 @@ trace_ppm(
         weno_reconstruct_7z(s_weno7, sm, sp);
         ppm_int_profile(sm, sp, s_weno7[3], un, cc, dtdx, Ip[n], Im[n]);
 
-      } else if (use_hybrid_weno && weno_scheme == 3) {
+      } else if (recon == ppm_weno3z) {
 
         amrex::Real s_weno3[3];
         if (idir == 0) {
@@ -550,3 +560,75 @@ trace_ppm(
     }
   });
 }
+
+template <int idir>
+void
+trace_ppm_dispatch(
+  const amrex::Box& bx,
+  amrex::Array4<amrex::Real const> const& q_arr,
+  amrex::Array4<amrex::Real> const& qm,
+  amrex::Array4<amrex::Real> const& qp,
+  const amrex::Box& vbx,
+  const amrex::Real dtdx,
+  const int recon,
+  const int flattening)
+{
+  int ispec = 0;
+  while (ispec < n_ppm_specializations &&
+         (ppm_specializations[ispec].recon != recon ||
+          ppm_specializations[ispec].flattening != flattening)) {
+    ispec++;
+  }
+
+  switch (ispec) {
+  case 0:
+    trace_ppm_dir<
+      idir, ppm_specializations[0].recon, ppm_specializations[0].flattening>(
+      bx, q_arr, qm, qp, vbx, dtdx, recon, flattening);
+    break;
+  case 1:
+    trace_ppm_dir<
+      idir, ppm_specializations[1].recon, ppm_specializations[1].flattening>(
+      bx, q_arr, qm, qp, vbx, dtdx, recon, flattening);
+    break;
+  case 2:
+    trace_ppm_dir<
+      idir, ppm_specializations[2].recon, ppm_specializations[2].flattening>(
+      bx, q_arr, qm, qp, vbx, dtdx, recon, flattening);
+    break;
+  default:
+    trace_ppm_dir<idir, ppm_generic, -1>(
+      bx, q_arr, qm, qp, vbx, dtdx, recon, flattening);
+  }
+}
+
+void
+trace_ppm(
+  const amrex::Box& bx,
+  const int idir,
+  amrex::Array4<amrex::Real const> const& q_arr,
+  amrex::Array4<amrex::Real const> const& /*srcQ*/,
+  amrex::Array4<amrex::Real> const& qm,
+  amrex::Array4<amrex::Real> const& qp,
+  const amrex::Box& vbx,
+  const amrex::Real dt,
+  const amrex::Real* dx,
+  const int use_flattening,
+  const int use_hybrid_weno,
+  const int weno_scheme)
+{
+  BL_PROFILE("trace_ppm()");
+
+  // The flattening coefficient is only used by the PPM reconstruction
+  const int recon = ppm_reconstruction(use_hybrid_weno, weno_scheme);
+  const int flattening = (recon == ppm_ppm && use_flattening == 1) ? 1 : 0;
+  const amrex::Real dtdx = dt / dx[idir];
+
+  if (idir == 0) {
+    trace_ppm_dispatch<0>(bx, q_arr, qm, qp, vbx, dtdx, recon, flattening);
+  } else if (idir == 1) {
+    trace_ppm_dispatch<1>(bx, q_arr, qm, qp, vbx, dtdx, recon, flattening);
+  } else {
+    trace_ppm_dispatch<2>(bx, q_arr, qm, qp, vbx, dtdx, recon, flattening);
+  }
+}
@@ -45,6 +45,7 @@ Real PeleC::particle_cfl = 0.4;
 
 int PeleC::write_particle_plotfiles = 1;
 int PeleC::write_spray_ascii_files = 1;
+int PeleC::particle_sort_int = -1;
 int PeleC::particle_mass_tran = 0;
 int PeleC::particle_heat_tran = 0;
 int PeleC::particle_mom_tran = 0;
@@ -154,6 +155,9 @@ PeleC::readParticleParams()
   // Set if spray ascii files should be written
   ppp.query("write_spray_ascii_files", write_spray_ascii_files);
 
+  // How often (number of level 0 steps) to sort the particles by cell
+  ppp.query("sort_int", particle_sort_int);
+
   // Used in initData() on startup to read in a file of particles.
   ppp.query("particle_init_file", particle_init_file);
 
@@ -410,10 +414,33 @@ PeleC::particleDerive(const std::string& name, Real time, int ngrow)
   }
 }
 
+// Reorder the spray particles of every tile by cell, so that moveKickDrift
+// and moveKick read the gas state and deposit the spray sources of
+// neighbouring particles from neighbouring memory. The particles move less
+// than a cell per step, so the order degrades slowly between sorts.
+void
+PeleC::particleSort()
+{
+  if (
+    particle_sort_int <= 0 || theSprayPC() == nullptr ||
+    parent->levelSteps(0) % particle_sort_int != 0) {
+    return;
+  }
+
+  BL_PROFILE("PeleC::particleSort()");
+  if (particle_verbose) {
+    amrex::Print() << "Sorting spray particles by cell\n";
+  }
+  theSprayPC()->SortParticlesByCell();
+}
+
 void
 PeleC::particleRedistribute(int lbase, int nGrow, int local, bool init_part)
 {
   BL_PROFILE("PeleC::particleRedistribute()");
+  // The work estimates are only charged by the callers in the step: after a
+  // regrid or at initialization, the next step starts them over
+  TelemetryTimer tel(tel_particles);
   int flev = parent->finestLevel();
   if (theSprayPC()) {
     amrex::Gpu::LaunchSafeGuard lsg(true);
@@ -86,6 +86,7 @@ int PeleC::les_filter_type = no_filter;
 int PeleC::les_filter_fgr = 1;
 int PeleC::les_test_filter_type = box_3pt_optimized_approx;
 int PeleC::les_test_filter_fgr = 2;
+int PeleC::les_dynamic_update_int = 1;
 
 bool PeleC::eb_in_domain = false;
 #ifdef PELEC_USE_EB
@@ -94,8 +95,13 @@ bool PeleC::body_state_set = false;
 amrex::GpuArray<amrex::Real, NVAR> PeleC::body_state;
 #endif
 
-bool PeleC::do_react_load_balance = false;
-bool PeleC::do_mol_load_balance = false;
+bool PeleC::do_load_balance = false;
+amrex::Vector<amrex::Real> PeleC::cost_phase_weights(num_cost_phases, 1.0);
+amrex::Array<amrex::Real, num_telemetry_phases> PeleC::telemetry_time = {
+  {0.0}};
+amrex::Vector<amrex::Real> PeleC::telemetry_cells;
+amrex::Real PeleC::telemetry_rhs = 0.0;
+amrex::Real PeleC::telemetry_step_start = -1.0;
 
 amrex::Vector<std::string> PeleC::spec_names;
 
@@ -257,6 +263,10 @@ PeleC::read_params()
     pp.query("les_model", les_model);
     pp.query("les_test_filter_type", les_test_filter_type);
     pp.query("les_test_filter_fgr", les_test_filter_fgr);
+    pp.query("les_dynamic_update_int", les_dynamic_update_int);
+    if (les_dynamic_update_int < 1) {
+      amrex::Abort("les_dynamic_update_int must be at least 1");
+    }
   }
 
   if (use_explicit_filter) {
@@ -313,6 +323,66 @@ PeleC::read_params()
 
 #ifdef AMREX_PARTICLES
   readParticleParams();
+
+  if (use_retry && do_spray_particles) {
+    amrex::Abort("use_retry is not supported with spray particles");
+  }
+
+  if (mol_single_exchange && do_spray_particles) {
+    amrex::Abort("mol_single_exchange is not supported with spray particles");
+  }
+#endif
+
+  if (mol_single_exchange) {
+    if (do_mol == 0) {
+      amrex::Abort("mol_single_exchange requires do_mol = 1");
+    }
+    if (mol_overlap_comm) {
+      amrex::Abort("mol_single_exchange cannot be used with mol_overlap_comm");
+    }
+    if (
+      use_explicit_filter || do_les || add_ext_src || add_forcing_src ||
+      do_mms) {
+      amrex::Abort("mol_single_exchange does not support explicit filtering "
+                   "or additional source terms");
+    }
+  }
+
+  if (implicit_diffusion) {
+    if (!do_diffuse) {
+      implicit_diffusion = 0;
+    }
+    if (mol_single_exchange) {
+      amrex::Abort(
+        "implicit_diffusion cannot be used with mol_single_exchange");
+    }
+  }
+
+  if (diffusion_rkl) {
+    if (!do_diffuse) {
+      diffusion_rkl = 0;
+    } else if (diffusion_rkl != 1 && diffusion_rkl != 2) {
+      amrex::Abort("diffusion_rkl must be 0, 1 or 2");
+    }
+    if (diffusion_rkl_max_stages < 2) {
+      amrex::Abort("diffusion_rkl_max_stages must be at least 2");
+    }
+    if (implicit_diffusion) {
+      amrex::Abort("diffusion_rkl cannot be used with implicit_diffusion");
+    }
+    if (mol_single_exchange) {
+      amrex::Abort("diffusion_rkl cannot be used with mol_single_exchange");
+    }
+  }
+
+  if (use_retry && retry_subcycle_factor < 2) {
+    amrex::Abort("retry_subcycle_factor must be at least 2");
+  }
+
+#ifndef USE_SUNDIALS_PP
+  if (retry_chem_integrator > 1) {
+    amrex::Abort("retry_chem_integrator=2,3 requires Sundials to be enabled");
+  }
 #endif
 
 #ifdef PELEC_USE_EB
@@ -332,8 +402,18 @@ PeleC::read_params()
 
   // This turns on the lb stuff inside Amr, but we use our own flag to signal
   // whether to gather data
-  ppa.query("loadbalance_with_workestimates", do_mol_load_balance);
-  ppa.query("loadbalance_with_workestimates", do_react_load_balance);
+  ppa.query("loadbalance_with_workestimates", do_load_balance);
+
+  // Weights of the mol, godunov, react, les, spray and sources phases in the
+  // work estimates
+  if (pp.contains("cost_phase_weights")) {
+    pp.getarr("cost_phase_weights", cost_phase_weights);
+    if (cost_phase_weights.size() != num_cost_phases) {
+      amrex::Abort(
+        "cost_phase_weights needs one weight for each of the mol, godunov, "
+        "react, les, spray and sources phases");
+    }
+  }
 }
 
 PeleC::PeleC()
@@ -386,10 +466,11 @@ PeleC::PeleC(
       newGrow = amrex::max<amrex::Real>(1, newGrow);
     }
 #endif
+    const int ncomp = source_num_comp(src_list[n]);
     old_sources[src_list[n]] = std::make_unique<amrex::MultiFab>(
-      grids, dmap, NVAR, oldGrow, amrex::MFInfo(), Factory());
+      grids, dmap, ncomp, oldGrow, amrex::MFInfo(), Factory());
     new_sources[src_list[n]] = std::make_unique<amrex::MultiFab>(
-      grids, dmap, NVAR, newGrow, amrex::MFInfo(), Factory());
+      grids, dmap, ncomp, newGrow, amrex::MFInfo(), Factory());
   }
 
   if (do_hydro) {
@@ -646,7 +727,7 @@ PeleC::initData()
   get_new_data(Reactions_Type).setVal(0.0);
 #endif
 
-  if (do_mol_load_balance || do_react_load_balance) {
+  if (do_load_balance) {
     get_new_data(Work_Estimate_Type).setVal(1.0);
   }
 
@@ -697,6 +778,7 @@ void
 PeleC::init(AmrLevel& old)
 {
   BL_PROFILE("PeleC::init(old)");
+  TelemetryTimer tel(tel_regrid);
 
   auto* oldlev = (PeleC*)&old;
 
@@ -721,7 +803,7 @@ PeleC::init(AmrLevel& old)
   }
 #endif
 
-  if (do_mol_load_balance || do_react_load_balance) {
+  if (do_load_balance) {
     amrex::MultiFab& work_estimate_new = get_new_data(Work_Estimate_Type);
     FillPatch(
       old, work_estimate_new, 0, cur_time, Work_Estimate_Type, 0,
@@ -735,6 +817,7 @@ PeleC::init()
   // This version inits the data on a new level that did not
   // exist before regridding.
   BL_PROFILE("PeleC::init()");
+  TelemetryTimer tel(tel_regrid);
 
   amrex::Real dt = parent->dtLevel(level);
   amrex::Real cur_time = getLevel(level - 1).state[State_Type].curTime();
@@ -747,7 +830,7 @@ PeleC::init()
   amrex::MultiFab& S_new = get_new_data(State_Type);
   FillCoarsePatch(S_new, 0, cur_time, State_Type, 0, NVAR);
 
-  if (do_mol_load_balance || do_react_load_balance) {
+  if (do_load_balance) {
     amrex::MultiFab& work_estimate_new = get_new_data(Work_Estimate_Type);
     int ncomp = work_estimate_new.nComp();
     FillCoarsePatch(
@@ -797,9 +880,6 @@ amrex::Real PeleC::estTimeStep(amrex::Real /*dt_old*/)
 
   const amrex::Real max_dt_over_cfl = max_dt / cfl;
   amrex::Real estdt_hydro = max_dt_over_cfl;
-  amrex::Real estdt_vdif = max_dt_over_cfl;
-  amrex::Real estdt_tdif = max_dt_over_cfl;
-  amrex::Real estdt_edif = max_dt_over_cfl;
   if (do_hydro || do_mol || diffuse_vel || diffuse_temp || diffuse_enth) {
 
 #ifdef PELEC_USE_EB
@@ -835,89 +915,17 @@ amrex::Real PeleC::estTimeStep(amrex::Real /*dt_old*/)
       estdt_hydro = amrex::min<amrex::Real>(estdt_hydro, dt);
     }
 
-    if (diffuse_vel) {
-      pele::physics::transport::TransParm const* ltransparm =
-        pele::physics::transport::trans_parm_g;
-      amrex::Real dt = amrex::ReduceMin(
-        stateMF,
-#ifdef PELEC_USE_EB
-        flags,
-#endif
-        0,
-        [=] AMREX_GPU_HOST_DEVICE(
-          amrex::Box const& bx, const amrex::Array4<const amrex::Real>& fab_arr
-#ifdef PELEC_USE_EB
-          ,
-          const amrex::Array4<const amrex::EBCellFlag>& flag_arr
-#endif
-          ) noexcept -> amrex::Real {
-          return pc_estdt_veldif(
-            bx, fab_arr,
-#ifdef PELEC_USE_EB
-            flag_arr,
-#endif
-            AMREX_D_DECL(dx1, dx2, dx3), ltransparm);
-        });
-      estdt_vdif = amrex::min<amrex::Real>(estdt_vdif, dt);
-    }
-
-    if (diffuse_temp) {
-      pele::physics::transport::TransParm const* ltransparm =
-        pele::physics::transport::trans_parm_g;
-      amrex::Real dt = amrex::ReduceMin(
-        stateMF,
-#ifdef PELEC_USE_EB
-        flags,
-#endif
-        0,
-        [=] AMREX_GPU_HOST_DEVICE(
-          amrex::Box const& bx, const amrex::Array4<const amrex::Real>& fab_arr
-#ifdef PELEC_USE_EB
-          ,
-          const amrex::Array4<const amrex::EBCellFlag>& flag_arr
-#endif
-          ) noexcept -> amrex::Real {
-          return pc_estdt_tempdif(
-            bx, fab_arr,
-#ifdef PELEC_USE_EB
-            flag_arr,
-#endif
-            AMREX_D_DECL(dx1, dx2, dx3), ltransparm);
-        });
-      estdt_tdif = amrex::min<amrex::Real>(estdt_tdif, dt);
-    }
-
-    if (diffuse_enth) {
-      pele::physics::transport::TransParm const* ltransparm =
-        pele::physics::transport::trans_parm_g;
-      amrex::Real dt = amrex::ReduceMin(
-        stateMF,
-#ifdef PELEC_USE_EB
-        flags,
-#endif
-        0,
-        [=] AMREX_GPU_HOST_DEVICE(
-          amrex::Box const& bx, const amrex::Array4<const amrex::Real>& fab_arr
-#ifdef PELEC_USE_EB
-          ,
-          const amrex::Array4<const amrex::EBCellFlag>& flag_arr
-#endif
-          ) noexcept -> amrex::Real {
-          return pc_estdt_enthdif(
-            bx, fab_arr,
-#ifdef PELEC_USE_EB
-            flag_arr,
-#endif
-            AMREX_D_DECL(dx1, dx2, dx3), ltransparm);
-        });
-      estdt_edif = amrex::min<amrex::Real>(estdt_edif, dt);
+    if ((diffuse_vel || diffuse_temp || diffuse_enth) && !implicit_diffusion) {
+      amrex::Real estdt_diff = estDiffusiveTimeStep(stateMF);
+      if (diffusion_rkl) {
+        // The super-time-stepping sweep relaxes the diffusive limit up to
+        // its maximum number of stages
+        estdt_diff *=
+          pc_rkl_stability_factor(diffusion_rkl, diffusion_rkl_max_stages);
+      }
+      estdt_hydro = amrex::min<amrex::Real>(estdt_hydro, estdt_diff);
     }
 
-    estdt_hydro = amrex::min<amrex::Real>(
-      estdt_hydro,
-      amrex::min<amrex::Real>(
-        estdt_vdif, amrex::min<amrex::Real>(estdt_tdif, estdt_edif)));
-
     amrex::ParallelDescriptor::ReduceRealMin(estdt_hydro);
     estdt_hydro *= cfl;
 
@@ -952,6 +960,126 @@ amrex::Real PeleC::estTimeStep(amrex::Real /*dt_old*/)
   return estdt;
 }
 
+amrex::Real
+PeleC::estDiffusiveTimeStep(const amrex::MultiFab& S)
+{
+  BL_PROFILE("PeleC::estDiffusiveTimeStep()");
+
+  amrex::Real estdt = std::numeric_limits<amrex::Real>::max();
+
+#ifdef PELEC_USE_EB
+  auto const& fact =
+    dynamic_cast<amrex::EBFArrayBoxFactory const&>(S.Factory());
+  auto const& flags = fact.getMultiEBCellFlagFab();
+#endif
+
+  const amrex::Real* dx = geom.CellSize();
+  amrex::Real AMREX_D_DECL(dx1 = dx[0], dx2 = dx[1], dx3 = dx[2]);
+  const TransportTable ltable = transport_table;
+
+  if (diffuse_vel) {
+    pele::physics::transport::TransParm const* ltransparm =
+      pele::physics::transport::trans_parm_g;
+    amrex::Real dt = amrex::ReduceMin(
+      S,
+#ifdef PELEC_USE_EB
+      flags,
+#endif
+      0,
+      [=] AMREX_GPU_HOST_DEVICE(
+        amrex::Box const& bx, const amrex::Array4<const amrex::Real>& fab_arr
+#ifdef PELEC_USE_EB
+        ,
+        const amrex::Array4<const amrex::EBCellFlag>& flag_arr
+#endif
+        ) noexcept -> amrex::Real {
+        return pc_estdt_veldif(
+          bx, fab_arr,
+#ifdef PELEC_USE_EB
+          flag_arr,
+#endif
+          AMREX_D_DECL(dx1, dx2, dx3), ltransparm, ltable);
+      });
+    estdt = amrex::min<amrex::Real>(estdt, dt);
+  }
+
+  if (diffuse_temp) {
+    pele::physics::transport::TransParm const* ltransparm =
+      pele::physics::transport::trans_parm_g;
+    amrex::Real dt = amrex::ReduceMin(
+      S,
+#ifdef PELEC_USE_EB
+      flags,
+#endif
+      0,
+      [=] AMREX_GPU_HOST_DEVICE(
+        amrex::Box const& bx, const amrex::Array4<const amrex::Real>& fab_arr
+#ifdef PELEC_USE_EB
+        ,
+        const amrex::Array4<const amrex::EBCellFlag>& flag_arr
+#endif
+        ) noexcept -> amrex::Real {
+        return pc_estdt_tempdif(
+          bx, fab_arr,
+#ifdef PELEC_USE_EB
+          flag_arr,
+#endif
+          AMREX_D_DECL(dx1, dx2, dx3), ltransparm, ltable);
+      });
+    estdt = amrex::min<amrex::Real>(estdt, dt);
+  }
+
+  if (diffuse_enth) {
+    pele::physics::transport::TransParm const* ltransparm =
+      pele::physics::transport::trans_parm_g;
+    amrex::Real dt = amrex::ReduceMin(
+      S,
+#ifdef PELEC_USE_EB
+      flags,
+#endif
+      0,
+      [=] AMREX_GPU_HOST_DEVICE(
+        amrex::Box const& bx, const amrex::Array4<const amrex::Real>& fab_arr
+#ifdef PELEC_USE_EB
+        ,
+        const amrex::Array4<const amrex::EBCellFlag>& flag_arr
+#endif
+        ) noexcept -> amrex::Real {
+        return pc_estdt_enthdif(
+          bx, fab_arr,
+#ifdef PELEC_USE_EB
+          flag_arr,
+#endif
+          AMREX_D_DECL(dx1, dx2, dx3), ltransparm, ltable);
+      });
+    estdt = amrex::min<amrex::Real>(estdt, dt);
+  }
+
+  return estdt;
+}
+
+amrex::Real
+PeleC::error_controlled_dt(const amrex::Real dt_old)
+{
+  // No estimate before the first MOL step of this level
+  if (mol_dt_err <= 0.0) {
+    return std::numeric_limits<amrex::Real>::max();
+  }
+
+  const amrex::Real factor =
+    pc_pi_dt_factor(mol_dt_err, mol_dt_err_prev, mol_dt_safety);
+  if (verbose) {
+    amrex::Print() << "PeleC::error_controlled_dt at level " << level
+                   << ": relative error = " << mol_dt_err
+                   << ", previous = " << mol_dt_err_prev
+                   << ", factor = " << factor << ", dt = " << factor * dt_old
+                   << '\n';
+  }
+  mol_dt_err_prev = mol_dt_err;
+  mol_dt_err = 0.0;
+  return factor * dt_old;
+}
+
 void
 PeleC::computeNewDt(
   int finest_level,
@@ -978,6 +1106,24 @@ PeleC::computeNewDt(
     dt_min[i] = adv_level.estTimeStep(dt_level[i]);
   }
 
+  // The error controller can only shorten the step below the stability limit
+  if (do_mol && mol_dt_control && fixed_dt <= 0.0) {
+    for (int i = 0; i <= finest_level; i++) {
+      const amrex::Real dt_err = getLevel(i).error_controlled_dt(dt_level[i]);
+      const bool error_limited = dt_err < dt_min[i];
+      if (verbose) {
+        amrex::Print() << "PeleC::compute_new_dt : "
+                       << (error_limited ? "error" : "stability")
+                       << "-limited dt at level " << i << ": "
+                       << amrex::min<amrex::Real>(dt_err, dt_min[i])
+                       << " (stability limit " << dt_min[i] << ")\n";
+      }
+      if (error_limited) {
+        dt_min[i] = dt_err;
+      }
+    }
+  }
+
   if (fixed_dt <= 0.0) {
     if (post_regrid_flag == 1) {
       // Limit dt's by pre-regrid dt
@@ -1091,9 +1237,12 @@ PeleC::post_timestep(int
     // Sync up if we're level 0 or if we have particles that may have moved
     // off the next finest level and need to be added to our own level.
     if ((iteration < ncycle && level < finest_level) || level == 0) {
+      TelemetryTimer tel(tel_particles);
+      const amrex::Real wt = amrex::ParallelDescriptor::second();
       // TODO: Determine how many ghost cells to use here
       int nGrow = iteration;
       theSprayPC()->Redistribute(level, theSprayPC()->finestLevel(), nGrow);
+      add_redistribute_cost(level, wt);
     }
   }
 #endif
@@ -1191,6 +1340,32 @@ PeleC::postCoarseTimeStep(amrex::Real cumtime)
 {
   BL_PROFILE("PeleC::postCoarseTimeStep()");
   AmrLevel::postCoarseTimeStep(cumtime);
+
+  const int nstep = parent->levelSteps(0);
+  if ((light_check_int > 0) && (nstep % light_check_int == 0)) {
+    for (int lev = 0; lev <= parent->finestLevel(); ++lev) {
+      getLevel(lev).writeLightCheckpoint();
+    }
+
+    // Every light_check_promote_int lightweight checkpoints, the state is
+    // also written to disk, so that it survives a node or job failure
+    if (
+      (light_check_promote_int > 0) &&
+      ((nstep / light_check_int) % light_check_promote_int == 0) &&
+      (parent->stepOfLastCheckPoint() < nstep)) {
+      parent->checkPoint();
+    }
+  }
+
+  write_telemetry(cumtime);
+
+  // The buffers are defined collectively, so the counts agree on all ranks
+  if (verbose > 1) {
+    amrex::Print() << "Advance buffers allocated: "
+                   << LevelBuffers::num_allocated()
+                   << ", reused: " << LevelBuffers::num_reused() << std::endl;
+  }
+  LevelBuffers::reset_counts();
 }
 
 void
@@ -1203,7 +1378,11 @@ PeleC::post_regrid(
   int /*new_finest*/)
 {
   BL_PROFILE("PeleC::post_regrid()");
-  fine_mask.clear();
+  {
+    TelemetryTimer tel(tel_regrid);
+    fine_mask.clear();
+    covered_mask.clear();
+  }
 
 #ifdef AMREX_PARTICLES
   if (do_spray_particles && theSprayPC() != 0 && level == lbase) {
@@ -1291,11 +1470,44 @@ PeleC::okToContinue()
     amrex::Print()
       << " Signalling a stop of the run due to signalStopJob = true."
       << std::endl;
-  } else if (parent->dtLevel(0) < dt_cutoff) {
+  } else if (
+    (parent->dtLevel(0) < dt_cutoff) ||
+    (parent->levelSteps(0) == light_check_test_rollback)) {
     test = 0;
 
-    amrex::Print() << " Signalling a stop of the run because dt < dt_cutoff."
-                   << std::endl;
+    if (parent->dtLevel(0) < dt_cutoff) {
+      amrex::Print() << " Signalling a stop of the run because dt < dt_cutoff."
+                     << std::endl;
+    } else {
+      amrex::Print() << " Signalling a stop of the run to test the rollback "
+                     << "(light_check_test_rollback)." << std::endl;
+    }
+
+    if (light_check_rollback && (light_check_int > 0)) {
+      const int finest_level = parent->finestLevel();
+      bool valid = true;
+      for (int lev = 0; lev <= finest_level; ++lev) {
+        valid = valid && getLevel(lev).validLightCheckpoint(light_ckpt_step);
+      }
+      if (valid) {
+        for (int lev = 0; lev <= finest_level; ++lev) {
+          getLevel(lev).restoreLightCheckpoint();
+        }
+        parent->setCumTime(light_ckpt_time);
+        amrex::Print() << " Rolled back to the lightweight checkpoint at step "
+                       << light_ckpt_step << "." << std::endl;
+
+        // Promote the restored state to a full checkpoint, unless one at or
+        // after this step is already on disk.
+        if (parent->stepOfLastCheckPoint() < parent->levelSteps(0)) {
+          parent->checkPoint();
+        }
+      } else {
+        amrex::Print() << " No lightweight checkpoint matches the current "
+                       << "grids; the final checkpoint holds the current state."
+                       << std::endl;
+      }
+    }
   }
 
   return test;
@@ -1305,6 +1517,7 @@ void
 PeleC::reflux()
 {
   BL_PROFILE("PeleC::reflux()");
+  TelemetryTimer tel(tel_reflux);
 
   AMREX_ASSERT(level < parent->finestLevel());
 
@@ -1538,10 +1751,11 @@ PeleC::errorEst(
   int /*clearval*/,
   int /*tagval*/,
   amrex::Real time,
-  int /*n_error_buf*/,
+  int n_error_buf,
   int /*ngrow*/)
 {
   BL_PROFILE("PeleC::errorEst()");
+  TelemetryTimer tel(tel_regrid);
 
   amrex::MultiFab S_data(
     get_new_data(State_Type).boxArray(),
@@ -1777,6 +1991,12 @@ PeleC::errorEst(
       // temp_eli.clear();
     }
   }
+
+  if (
+    tagging_parm->predict_front != 0 &&
+    level < tagging_parm->max_predict_lev) {
+    predictive_tagging(tags, n_error_buf);
+  }
 }
 
 std::unique_ptr<amrex::MultiFab>
@@ -2120,6 +2340,36 @@ PeleC::build_fine_mask()
   return fine_mask;
 }
 
+const amrex::iMultiFab*
+PeleC::build_covered_mask()
+{
+  if (!skip_covered_cells || !do_reflux || level == parent->finestLevel()) {
+    return nullptr;
+  }
+
+  if (!covered_mask.empty()) {
+    return &covered_mask;
+  }
+
+  // Each stage of the advance widens the region of covered cells that
+  // feeds the coarse-fine interface by the stencil width, and one more cell
+  // is needed to interpolate ghost cells of the finer level
+  const int nstages = do_mol ? 1 + mol_iters : sdc_iters;
+  const int nbuf = nstages * (numGrow() + nGrowF) + 1;
+
+  amrex::BoxArray cfba = parent->boxArray(level + 1);
+  cfba.coarsen(fine_ratio);
+  amrex::BoxArray near_uncovered = amrex::complementIn(geom.Domain(), cfba);
+  near_uncovered.grow(nbuf);
+
+  const int ng = get_new_data(State_Type).nGrow();
+  covered_mask = amrex::makeFineMask(
+    grids, dmap, amrex::IntVect(ng), near_uncovered, amrex::IntVect(1),
+    geom.periodicity(), 1, 0);
+
+  return &covered_mask;
+}
+
 const amrex::iMultiFab*
 PeleC::build_interior_boundary_mask(int ng)
 {
@@ -1,9 +1,28 @@
 #include "PeleC.H"
 #include "React.H"
+#include "Utilities.H"
 #ifdef USE_SUNDIALS_PP
 #include "reactor.h"
 #endif
 
+#ifdef USE_SUNDIALS_PP
+// Keep the first cell in which the chemistry integration failed
+static void
+record_react_failure(int* fail_loc, const amrex::IntVect& iv)
+{
+#ifdef _OPENMP
+#pragma omp critical(pelec_react_failure)
+#endif
+  {
+    if (fail_loc[0] == std::numeric_limits<int>::lowest()) {
+      for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+        fail_loc[dir] = iv[dir];
+      }
+    }
+  }
+}
+#endif
+
 void
 PeleC::react_state(
   amrex::Real /*time*/,
@@ -13,6 +32,7 @@ PeleC::react_state(
 {
   // Update I_R, and recompute S_new
   BL_PROFILE("PeleC::react_state()");
+  TelemetryTimer tel(tel_reactions);
 
   const amrex::Real strt_time = amrex::ParallelDescriptor::second();
 
@@ -32,11 +52,11 @@ PeleC::react_state(
   prefetchToDevice(S_new);
 
   // Create a MultiFab with all of the non-reacting source terms.
-  amrex::MultiFab non_react_src_tmp;
   amrex::MultiFab* non_react_src = nullptr;
 
   if (react_init) {
-    non_react_src_tmp.define(grids, dmap, NVAR, ng, amrex::MFInfo(), Factory());
+    amrex::MultiFab& non_react_src_tmp =
+      buffers.get(buf_non_react_src, grids, dmap, NVAR, ng, &Factory());
     non_react_src_tmp.setVal(0);
     non_react_src = &non_react_src_tmp;
   } else {
@@ -44,16 +64,16 @@ PeleC::react_state(
     // Build non-reacting source term, and an S_new that does not include
     // reactions
     if (aux_src == nullptr) {
-      non_react_src_tmp.define(
-        grids, dmap, NVAR, ng, amrex::MFInfo(), Factory());
+      amrex::MultiFab& non_react_src_tmp =
+        buffers.get(buf_non_react_src, grids, dmap, NVAR, ng, &Factory());
       non_react_src_tmp.setVal(0);
       non_react_src = &non_react_src_tmp;
 
       for (int n = 0; n < src_list.size(); ++n) {
-        amrex::MultiFab::Saxpy(
-          non_react_src_tmp, 0.5, *new_sources[src_list[n]], 0, 0, NVAR, ng);
-        amrex::MultiFab::Saxpy(
-          non_react_src_tmp, 0.5, *old_sources[src_list[n]], 0, 0, NVAR, ng);
+        saxpy_source(
+          non_react_src_tmp, 0.5, *new_sources[src_list[n]], src_list[n], ng);
+        saxpy_source(
+          non_react_src_tmp, 0.5, *old_sources[src_list[n]], src_list[n], ng);
       }
 
       if (do_hydro && !do_mol) {
@@ -77,11 +97,15 @@ PeleC::react_state(
 
 #ifdef USE_SUNDIALS_PP
   // for sundials box integration
-  amrex::MultiFab STemp(grids, dmap, NUM_SPECIES + 2, 0);
-  amrex::MultiFab extsrc_rY(grids, dmap, NUM_SPECIES, 0);
-  amrex::MultiFab extsrc_rE(grids, dmap, 1, 0);
-  amrex::iMultiFab dummyMask(grids, dmap, 1, 0);
-  amrex::MultiFab fctCount(grids, dmap, 1, 0);
+  amrex::MultiFab& STemp =
+    buffers.get(buf_react_state, grids, dmap, NUM_SPECIES + 2, 0);
+  amrex::MultiFab& extsrc_rY =
+    buffers.get(buf_react_extsrc_rY, grids, dmap, NUM_SPECIES, 0);
+  amrex::MultiFab& extsrc_rE =
+    buffers.get(buf_react_extsrc_rE, grids, dmap, 1, 0);
+  amrex::iMultiFab& dummyMask = buffers.iget(buf_react_mask, grids, dmap, 1, 0);
+  amrex::MultiFab& fctCount =
+    buffers.get(buf_react_fct_count, grids, dmap, 1, 0);
   dummyMask.setVal(1);
 
   if (chem_integrator == 3) {
@@ -105,8 +129,30 @@ PeleC::react_state(
   auto const& flags = fact.getMultiEBCellFlagFab();
 #endif
 
+  // Covered cells keep the non-reacting update and a zero I_R until they
+  // are overwritten by avgDown
+  const amrex::iMultiFab* covered = react_init ? nullptr : build_covered_mask();
+
+  // Right-hand side evaluations for the telemetry, per cell with the
+  // explicit integrator
+  const bool count_rhs = telemetry_active();
+  amrex::Real rhs_evals = 0.0;
+  amrex::MultiFab rhs_count;
+  if (count_rhs && chem_integrator == 1) {
+    rhs_count.define(grids, dmap, 1, ng, amrex::MFInfo(), Factory());
+    rhs_count.setVal(0.0);
+  }
+
+  // Number of cells in which CVODE did not reach the end of the step, and the
+  // first of them on this rank
+  int num_failed = 0;
+  int fail_loc[AMREX_SPACEDIM] = {AMREX_D_DECL(
+    std::numeric_limits<int>::lowest(), std::numeric_limits<int>::lowest(),
+    std::numeric_limits<int>::lowest())};
+
 #ifdef _OPENMP
-#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())               \
+    reduction(+:rhs_evals,num_failed)
 #endif
   {
     for (amrex::MFIter mfi(S_new, amrex::TilingIfNotGPU()); mfi.isValid();
@@ -114,6 +160,18 @@ PeleC::react_state(
 
       const amrex::Box& bx = mfi.growntilebox(ng);
 
+      // Masked tiles keep the non-reacting update and a zero I_R. The zero is
+      // set here as well as above, so that it does not rely on react_src
+      // being cleared for the whole level.
+      if (
+        (covered != nullptr) &&
+        ((*covered)[mfi].min<amrex::RunOn::Device>(bx, 0) == 1)) {
+        react_src[mfi].setVal<amrex::RunOn::Device>(0.0, bx);
+        continue;
+      }
+
+      const amrex::Real wt = amrex::ParallelDescriptor::second();
+
       // old state or the state at t=0
       auto const& sold_arr =
         react_init ? S_new.array(mfi) : get_old_data(State_Type).array(mfi);
@@ -133,11 +191,6 @@ PeleC::react_state(
       const auto& flag_fab = flags[mfi];
       amrex::FabType typ = flag_fab.getType(bx);
       if (typ == amrex::FabType::covered) {
-        if (do_react_load_balance) {
-          const amrex::Box vbox = mfi.tilebox();
-          get_new_data(Work_Estimate_Type)[mfi].plus<amrex::RunOn::Device>(
-            0.0, vbox);
-        }
         continue;
       }
       if (typ == amrex::FabType::singlevalued || typ == amrex::FabType::regular)
@@ -154,25 +207,39 @@ PeleC::react_state(
           // for rk64 we set the error tolerance
           const amrex::Real errtol = adaptrk_errtol;
 
+          const bool skip_covered = (covered != nullptr);
+          const auto& cmask =
+            skip_covered ? covered->const_array(mfi)
+                         : amrex::Array4<const int>();
+          const bool count_cell_rhs = rhs_count.ok();
+          const auto& nrhs = count_cell_rhs ? rhs_count.array(mfi)
+                                            : amrex::Array4<amrex::Real>();
+
           amrex::ParallelFor(
             bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-              pc_expl_reactions(
+              if (skip_covered && (cmask(i, j, k) == 1)) {
+                for (int n = 0; n < I_R.nComp(); n++) {
+                  I_R(i, j, k, n) = 0.0;
+                }
+                return;
+              }
+              const int n = pc_expl_reactions(
                 i, j, k, sold_arr, snew_arr, nonrs_arr, I_R, dt, nsubsteps_min,
                 nsubsteps_max, nsubsteps_guess, errtol, do_update,
                 captured_clean_massfrac);
+              if (count_cell_rhs) {
+                nrhs(i, j, k) = n;
+              }
             });
         }
 
         else if (chem_integrator == 2 || chem_integrator == 3) {
 #ifdef USE_SUNDIALS_PP
-          amrex::Real wt =
-            amrex::ParallelDescriptor::second(); // timing for each fab
           const int captured_chem_integrator = chem_integrator;
 
           const auto len = amrex::length(bx);
           const auto lo = amrex::lbound(bx);
           const int ncells = len.x * len.y * len.z;
-          amrex::Real current_time = 0.0;
 
           // for flattened array integration
           amrex::Vector<amrex::Real> h_rY_in(ncells * (NUM_SPECIES + 1));
@@ -278,33 +345,55 @@ PeleC::react_state(
 #endif
             amrex::Real chemintg_cost = 0.0;
             for (int i = 0; i < ncells; i += ode_ncells) {
-
+              // react() advances its time argument to the time the
+              // integrator reached, which falls short of dt if CVODE fails
+              amrex::Real dt_react = dt;
+              amrex::Real current_time = 0.0;
 #ifdef AMREX_USE_GPU
               chemintg_cost += react(
                 &h_rY_in[i * (NUM_SPECIES + 1)], &h_rY_src_in[i * NUM_SPECIES],
-                &h_re_in[i], &h_re_src_in[i], dt, current_time, 1, ode_ncells,
-                amrex::Gpu::gpuStream());
+                &h_re_in[i], &h_re_src_in[i], dt_react, current_time, 1,
+                ode_ncells, amrex::Gpu::gpuStream());
 #else
               chemintg_cost += react(
                 &h_rY_in[i * (NUM_SPECIES + 1)], &h_rY_src_in[i * NUM_SPECIES],
-                &h_re_in[i], &h_re_src_in[i], dt, current_time);
+                &h_re_in[i], &h_re_src_in[i], dt_react, current_time);
 #endif
+              if (!pc_react_reached(current_time, dt)) {
+                num_failed += ode_ncells;
+                const amrex::IntVect iv(AMREX_D_DECL(
+                  lo.x + i % len.x, lo.y + (i / len.x) % len.y,
+                  lo.z + i / (len.x * len.y)));
+                record_react_failure(fail_loc, iv);
+              }
             }
+            rhs_evals += chemintg_cost;
             chemintg_cost = chemintg_cost / ncells;
 
             amrex::Gpu::copy(
               amrex::Gpu::hostToDevice, h_rY_in.begin(), h_rY_in.end(),
               rY_in.begin());
           } else {
+            amrex::Real dt_react = dt;
+            amrex::Real current_time = 0.0;
 #ifdef AMREX_USE_GPU
             const int reactor_type = 1;
             react(
-              bx, rhoY, frcExt, T, rhoE, frcEExt, fc, mask, dt, current_time,
-              reactor_type, amrex::Gpu::gpuStream());
+              bx, rhoY, frcExt, T, rhoE, frcEExt, fc, mask, dt_react,
+              current_time, reactor_type, amrex::Gpu::gpuStream());
 #else
             react(
-              bx, rhoY, frcExt, T, rhoE, frcEExt, fc, mask, dt, current_time);
+              bx, rhoY, frcExt, T, rhoE, frcEExt, fc, mask, dt_react,
+              current_time);
 #endif
+            if (!pc_react_reached(current_time, dt)) {
+              num_failed += ncells;
+              record_react_failure(fail_loc, bx.smallEnd());
+            }
+            if (count_rhs) {
+              rhs_evals +=
+                fctCount[mfi].sum<amrex::RunOn::Device>(mfi.tilebox(), 0);
+            }
           }
 
           // unpack data
@@ -410,14 +499,6 @@ PeleC::react_state(
                   / dt -
                 nonrs_arr(i, j, k, UEDEN);
             });
-
-          wt = (amrex::ParallelDescriptor::second() - wt) / bx.d_numPts();
-
-          if (do_react_load_balance) {
-            const amrex::Box vbox = mfi.tilebox();
-            get_new_data(Work_Estimate_Type)[mfi].plus<amrex::RunOn::Device>(
-              wt, vbox);
-          }
 #else
           amrex::Abort(
             "chem_integrator=2,3 which requires Sundials to be enabled");
@@ -450,9 +531,32 @@ PeleC::react_state(
             }
           });
       }
+
+      add_box_cost(cost_react, mfi, wt);
     }
   }
 
+  if (rhs_count.ok()) {
+    rhs_evals += rhs_count.sum(0, true);
+  }
+  telemetry_rhs += rhs_evals;
+
+  // The failures add up over the reaction calls of the step, and the first
+  // failing cell is kept
+  amrex::ParallelDescriptor::ReduceIntSum(num_failed);
+  amrex::IntVect fail_cell(AMREX_D_DECL(fail_loc[0], fail_loc[1], fail_loc[2]));
+  const bool fail_found = pc_reduce_found_cell(
+    fail_loc[0] != std::numeric_limits<int>::lowest(), fail_cell);
+  if (fail_found && react_failures == 0) {
+    react_failure_cell = fail_cell;
+  }
+  react_failures += num_failed;
+  if (num_failed > 0) {
+    amrex::Print() << "PeleC::react_state(): CVODE did not reach the end "
+                   << "of the step in " << num_failed << " cells at level "
+                   << level << std::endl;
+  }
+
   if (ng > 0) {
     S_new.FillBoundary(geom.periodicity());
   }
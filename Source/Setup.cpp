@@ -25,6 +25,7 @@ ProbParmDevice* PeleC::h_prob_parm_device = nullptr;
 ProbParmHost* PeleC::prob_parm_host = nullptr;
 TaggingParm* PeleC::tagging_parm = nullptr;
 PassMap* PeleC::d_pass_map = nullptr;
+TransportTable PeleC::transport_table;
 PassMap* PeleC::h_pass_map = nullptr;
 
 // Components are:
@@ -164,6 +165,10 @@ PeleC::variableSetUp()
   pele::physics::transport::InitTransport<
     pele::physics::PhysicsType::eos_type>()();
 
+  if (use_transport_table) {
+    init_transport_table();
+  }
+
 #ifdef PELEC_USE_REACTIONS
 #if defined(AMREX_USE_GPU) && defined(USE_SUNDIALS_PP)
   amrex::sundials::MemoryHelper::Initialize();
@@ -441,7 +446,7 @@ PeleC::variableSetUp()
   desc_lst.setComponent(Reactions_Type, 0, react_name, react_bcs, bndryfunc2);
 #endif
 
-  if (do_react_load_balance || do_mol_load_balance) {
+  if (do_load_balance) {
     desc_lst.addDescriptor(
       Work_Estimate_Type, amrex::IndexType::TheCellType(),
       amrex::StateDescriptor::Point, 0, 1, &amrex::pc_interp);
@@ -652,6 +657,8 @@ PeleC::variableCleanUp()
 
   desc_lst.clear();
 
+  close_transport_table();
+
   pele::physics::transport::CloseTransport<
     pele::physics::PhysicsType::eos_type>()();
 
@@ -678,7 +685,7 @@ PeleC::variableCleanUp()
 void
 PeleC::set_active_sources()
 {
-  if (do_diffuse && !do_mol) {
+  if (do_diffuse && !do_mol && !diffusion_split()) {
     src_list.push_back(diff_src);
   }
 
@@ -78,7 +78,7 @@ PeleC::sum_of_sources(amrex::MultiFab& source)
   source.setVal(0.0);
 
   for (int n = 0; n < src_list.size(); ++n) {
-    amrex::MultiFab::Add(source, *old_sources[src_list[n]], 0, 0, NVAR, ng);
+    saxpy_source(source, 1.0, *old_sources[src_list[n]], src_list[n], ng);
   }
 
   if (do_hydro) {
@@ -86,6 +86,6 @@ PeleC::sum_of_sources(amrex::MultiFab& source)
   }
 
   for (int n = 0; n < src_list.size(); ++n) {
-    amrex::MultiFab::Add(source, *new_sources[src_list[n]], 0, 0, NVAR, ng);
+    saxpy_source(source, 1.0, *new_sources[src_list[n]], src_list[n], ng);
   }
 }
@@ -1,3 +1,7 @@
+#include <cmath>
+#include <limits>
+
+#include <AMReX_MultiFabUtil.H>
 #include <AMReX_ParmParse.H>
 
 #include "PeleC.H"
@@ -38,4 +42,280 @@ PeleC::read_tagging_params()
 
   pp.query("vfracerr", tagging_parm->vfracerr);
   pp.query("max_vfracerr_lev", tagging_parm->max_vfracerr_lev);
+
+  pp.query("predict_front", tagging_parm->predict_front);
+  pp.query("max_predict_lev", tagging_parm->max_predict_lev);
+  pp.query("max_predict_cells", tagging_parm->max_predict_cells);
+}
+
+// Skip the regrid of this level while the cells it tags stay at least
+// regrid_hysteresis cells inside the grids of the next finer level, so that
+// slowly moving features do not rebuild the finer levels on every regrid
+// interval. At most regrid_max_skips successive regrids are skipped, so that
+// the finer grids still shrink when a feature vanishes.
+int
+PeleC::okToRegrid()
+{
+  if (regrid_hysteresis < 0) {
+    return 1;
+  }
+
+  // Amr asks again on every step once the regrid interval has passed, so
+  // the next check waits for a full interval after a skipped regrid
+  const int step = parent->levelSteps(level);
+  if (
+    regrid_skip_step >= 0 &&
+    step - regrid_skip_step < parent->regridInt(level)) {
+    return 0;
+  }
+
+  if (regrid_skips >= regrid_max_skips) {
+    if (verbose) {
+      amrex::Print() << "PeleC::okToRegrid: regridding level " << level
+                     << " after " << regrid_skips << " skipped regrids"
+                     << std::endl;
+    }
+    regrid_skips = 0;
+    regrid_skip_step = -1;
+    return 1;
+  }
+
+  BL_PROFILE("PeleC::okToRegrid()");
+
+  amrex::TagBoxArray tags(grids, dmap, 0);
+  errorEst(
+    tags, amrex::TagBox::CLEAR, amrex::TagBox::SET,
+    state[State_Type].curTime(), parent->nErrorBuf(level)[0], 0);
+
+  // Cells of this level covered by the next finer level, including the
+  // ghost cells of the band
+  const int band = regrid_hysteresis;
+  const amrex::BoxArray fine_grids = level < parent->finestLevel()
+                                       ? parent->boxArray(level + 1)
+                                       : amrex::BoxArray();
+  const amrex::iMultiFab covered = amrex::makeFineMask(
+    grids, dmap, amrex::IntVect(band), fine_grids, parent->refRatio(level),
+    geom.periodicity(), 0, 1);
+
+  // Outside a non-periodic domain, the band needs no covering
+  const amrex::Box bounds = geom.growPeriodicDomain(band);
+  int nescaped = amrex::ReduceSum(
+    covered, tags, 0,
+    [=] AMREX_GPU_HOST_DEVICE(
+      amrex::Box const& bx, const amrex::Array4<const int>& mask,
+      const amrex::Array4<const char>& tag) noexcept -> int {
+      int n = 0;
+      amrex::Loop(bx, [&](int i, int j, int k) noexcept {
+        if (tag(i, j, k) == amrex::TagBox::CLEAR) {
+          return;
+        }
+        const amrex::IntVect iv(AMREX_D_DECL(i, j, k));
+        const amrex::Box nbr = amrex::grow(amrex::Box(iv, iv), band) & bounds;
+        bool inside = true;
+        amrex::Loop(nbr, [&](int ii, int jj, int kk) noexcept {
+          inside = inside && (mask(ii, jj, kk) != 0);
+        });
+        if (!inside) {
+          n++;
+        }
+      });
+      return n;
+    });
+  amrex::ParallelDescriptor::ReduceIntSum(nescaped);
+
+  if (nescaped > 0) {
+    if (verbose) {
+      amrex::Print() << "PeleC::okToRegrid: regridding level " << level
+                     << ", " << nescaped << " tagged cells are within "
+                     << band << " cells of the edge of level " << level + 1
+                     << std::endl;
+    }
+    regrid_skips = 0;
+    regrid_skip_step = -1;
+    return 1;
+  }
+
+  regrid_skips++;
+  regrid_skip_step = step;
+  if (verbose) {
+    amrex::Print() << "PeleC::okToRegrid: skipping the regrid of level "
+                   << level << " (" << regrid_skips << " of "
+                   << regrid_max_skips << "), the tagged cells are covered"
+                   << std::endl;
+  }
+  return 0;
+}
+
+// Dilate the tags in the direction in which the flame front moves, by the
+// distance it covers until the next regrid of this level. The front velocity
+// is that of the iso-surfaces of the flame tracer (or of the temperature),
+// -(dc/dt) grad(c) / |grad(c)|^2, from the last step of this level.
+void
+PeleC::predictive_tagging(amrex::TagBoxArray& tags, const int n_error_buf)
+{
+  BL_PROFILE("PeleC::predictive_tagging()");
+
+  const amrex::Real cur_time = state[State_Type].curTime();
+  const amrex::Real dt = cur_time - state[State_Type].prevTime();
+  if (!state[State_Type].hasOldData() || dt <= 0.0) {
+    return;
+  }
+
+  int comp = UTEMP;
+  if (!flame_trac_name.empty()) {
+    for (int n = 0; n < spec_names.size(); ++n) {
+      if (flame_trac_name == spec_names[n]) {
+        comp = UFS + n;
+      }
+    }
+  }
+  const bool massfrac = comp != UTEMP;
+
+  const int ng = tagging_parm->max_predict_cells;
+  const amrex::Real interval =
+    parent->regridInt(level) * parent->dtLevel(level);
+  const amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> dx = geom.CellSizeArray();
+
+  amrex::MultiFab S_new(grids, dmap, NVAR, 1);
+  FillPatch(*this, S_new, 1, cur_time, State_Type, 0, NVAR);
+  const amrex::MultiFab& S_old = get_old_data(State_Type);
+
+  // Whether a cell is tagged, then the number of cells the front moves in
+  // each direction until the next regrid, from the tagged cells
+  amrex::iMultiFab front(grids, dmap, 1 + AMREX_SPACEDIM, ng);
+  front.setVal(0);
+  for (amrex::MFIter mfi(front, amrex::TilingIfNotGPU()); mfi.isValid();
+       ++mfi) {
+    const amrex::Box& bx = mfi.tilebox();
+    const auto snew = S_new.const_array(mfi);
+    const auto sold = S_old.const_array(mfi);
+    const auto tag = tags.const_array(mfi);
+    const auto fr = front.array(mfi);
+    amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+      if (tag(i, j, k) == amrex::TagBox::CLEAR) {
+        return;
+      }
+      fr(i, j, k, 0) = 1;
+
+      auto tracer = [=](const amrex::Array4<const amrex::Real>& s, int ii,
+                        int jj, int kk) noexcept {
+        return massfrac ? s(ii, jj, kk, comp) / s(ii, jj, kk, URHO)
+                        : s(ii, jj, kk, comp);
+      };
+      const amrex::Real dcdt =
+        (tracer(snew, i, j, k) - tracer(sold, i, j, k)) / dt;
+      amrex::Real grad[AMREX_SPACEDIM];
+      amrex::Real grad2 = 0.0;
+      amrex::Real dxmin = dx[0];
+      for (int dir = 0; dir < AMREX_SPACEDIM; dir++) {
+        const int e[3] = {dir == 0, dir == 1, dir == 2};
+        grad[dir] = (tracer(snew, i + e[0], j + e[1], k + e[2]) -
+                     tracer(snew, i - e[0], j - e[1], k - e[2])) /
+                    (2.0 * dx[dir]);
+        grad2 += grad[dir] * grad[dir];
+        dxmin = amrex::min(dxmin, dx[dir]);
+      }
+
+      // Only cells in the front, where the tracer varies across the cell
+      const amrex::Real c = amrex::Math::abs(tracer(snew, i, j, k));
+      if (
+        grad2 <= std::numeric_limits<amrex::Real>::min() ||
+        std::sqrt(grad2) * dxmin < 1.0e-3 * c) {
+        return;
+      }
+      for (int dir = 0; dir < AMREX_SPACEDIM; dir++) {
+        const amrex::Real dist = -dcdt * grad[dir] / grad2 * interval;
+        const int cells = amrex::min<int>(
+          static_cast<int>(std::ceil(amrex::Math::abs(dist) / dx[dir])), ng);
+        fr(i, j, k, 1 + dir) = dist < 0.0 ? -cells : cells;
+      }
+    });
+  }
+
+  // Largest front displacement, in cells, before the tags are dilated
+  int max_cells = 0;
+  for (int dir = 0; dir < AMREX_SPACEDIM; dir++) {
+    max_cells = amrex::max(
+      max_cells,
+      amrex::max(front.max(1 + dir, 0, true), -front.min(1 + dir, 0, true)));
+  }
+  amrex::ParallelDescriptor::ReduceIntMax(max_cells);
+  if (max_cells == 0) {
+    return;
+  }
+  const amrex::Long ntagged = front.sum(0);
+
+  // Sweep the tags along each direction in turn. A cell reached by the
+  // displacement of a tagged cell is tagged and carries that displacement
+  // in the other directions.
+  amrex::iMultiFab swept(grids, dmap, 1 + AMREX_SPACEDIM, 0);
+  for (int dir = 0; dir < AMREX_SPACEDIM; dir++) {
+    front.FillBoundary(geom.periodicity());
+    for (amrex::MFIter mfi(front, amrex::TilingIfNotGPU()); mfi.isValid();
+         ++mfi) {
+      const amrex::Box& bx = mfi.tilebox();
+      const auto fr = front.const_array(mfi);
+      const auto sw = swept.array(mfi);
+      amrex::ParallelFor(
+        bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+          const int e[3] = {dir == 0, dir == 1, dir == 2};
+          int src[3] = {i, j, k};
+          bool found = fr(i, j, k, 0) != 0;
+          for (int o = 1; o <= ng && !found; o++) {
+            for (int sgn = -1; sgn <= 1 && !found; sgn += 2) {
+              // The cell o cells upstream, which moves by at least o cells
+              const int ii = i - sgn * o * e[0];
+              const int jj = j - sgn * o * e[1];
+              const int kk = k - sgn * o * e[2];
+              if (
+                fr(ii, jj, kk, 0) != 0 &&
+                sgn * fr(ii, jj, kk, 1 + dir) >= o) {
+                found = true;
+                src[0] = ii;
+                src[1] = jj;
+                src[2] = kk;
+              }
+            }
+          }
+          if (!found) {
+            for (int n = 0; n < 1 + AMREX_SPACEDIM; n++) {
+              sw(i, j, k, n) = 0;
+            }
+            return;
+          }
+          sw(i, j, k, 0) = 1;
+          for (int n = 1; n < 1 + AMREX_SPACEDIM; n++) {
+            sw(i, j, k, n) = fr(src[0], src[1], src[2], n);
+          }
+        });
+    }
+    amrex::iMultiFab::Copy(front, swept, 0, 0, 1 + AMREX_SPACEDIM, 0);
+  }
+
+  // Tag the swept cells
+  for (amrex::MFIter mfi(front, amrex::TilingIfNotGPU()); mfi.isValid();
+       ++mfi) {
+    const amrex::Box& bx = mfi.tilebox();
+    const auto fr = front.const_array(mfi);
+    const auto tag = tags.array(mfi);
+    amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+      if (fr(i, j, k, 0) != 0) {
+        tag(i, j, k) = amrex::TagBox::SET;
+      }
+    });
+  }
+
+  // Without the prediction, the tags follow the front for n_error_buf cells,
+  // so it would need this many regrids in the same interval
+  if (verbose) {
+    const amrex::Long nadded = front.sum(0) - ntagged;
+    const int nregrids =
+      (max_cells + amrex::max(n_error_buf, 1) - 1) / amrex::max(n_error_buf, 1);
+    amrex::Print() << "PeleC::predictive_tagging at level " << level
+                   << ": the front moves up to " << max_cells
+                   << " cells in a regrid interval of " << interval << ", "
+                   << nadded << " cells tagged in addition to " << ntagged
+                   << ", " << amrex::max(nregrids - 1, 0)
+                   << " regrids saved per interval" << std::endl;
+  }
 }
@@ -0,0 +1,128 @@
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "PeleC.H"
+
+// Per-step performance telemetry.
+//
+// The phases of the step add their wall time on this rank with
+// TelemetryTimer, the level advances count the cells they update and the
+// reactions count their right-hand side evaluations. After each coarse
+// timestep, these are reduced over the ranks and appended to telemetry_file
+// as one JSON record per line:
+//
+//    {"step": ..., "time": ..., "dt": ..., "wall": ...,
+//     "phases": {"fillpatch": ..., ...}, "cells": [...],
+//     "cell_updates": ..., "cell_updates_per_s": ..., "rhs_evals": ...,
+//     "rank_time_min": ..., "rank_time_max": ..., "fab_bytes_hwm": ...,
+//     "buffer_allocs": ..., "buffer_reuses": ...}
+//
+// where the phase times are the largest over the ranks, the cells are the
+// cells updated on each level (times the number of subcycles), the rank
+// times are the smallest and largest sums of the phase times over the ranks
+// and the buffer counts are the temporaries of the advance that were
+// allocated or reused from the previous steps.
+
+namespace {
+const char* const telemetry_phase_names[num_telemetry_phases] = {
+  "fillpatch", "hydro",  "diffusion", "reactions", "redistribution",
+  "reflux",    "regrid", "io",        "particles"};
+} // namespace
+
+// Wall time for the telemetry, after the pending device work has completed.
+// Returns 0 without synchronizing when the telemetry is off.
+amrex::Real
+PeleC::telemetry_clock()
+{
+  if (!telemetry_active()) {
+    return 0.0;
+  }
+  amrex::Gpu::streamSynchronize();
+  return amrex::ParallelDescriptor::second();
+}
+
+void
+PeleC::add_telemetry_time(const int phase, const amrex::Real t)
+{
+  if (telemetry_active()) {
+    telemetry_time[phase] += t;
+  }
+}
+
+void
+PeleC::write_telemetry(amrex::Real cumtime)
+{
+  if (!telemetry_active()) {
+    return;
+  }
+
+  BL_PROFILE("PeleC::write_telemetry()");
+
+  const amrex::Real now = amrex::ParallelDescriptor::second();
+  amrex::Real wall =
+    telemetry_step_start < 0.0 ? 0.0 : now - telemetry_step_start;
+
+  amrex::Real rank_time = 0.0;
+  for (int phase = 0; phase < num_telemetry_phases; phase++) {
+    rank_time += telemetry_time[phase];
+  }
+  amrex::Real rank_time_min = rank_time;
+  amrex::Real rank_time_max = rank_time;
+  amrex::Array<amrex::Real, num_telemetry_phases> phase_max = telemetry_time;
+  amrex::Real rhs = telemetry_rhs;
+  amrex::Real fab_bytes_hwm =
+    static_cast<amrex::Real>(amrex::TotalBytesAllocatedInFabsHWM());
+
+  const int IOProc = amrex::ParallelDescriptor::IOProcessorNumber();
+  amrex::ParallelDescriptor::ReduceRealMax(
+    phase_max.data(), num_telemetry_phases, IOProc);
+  amrex::ParallelDescriptor::ReduceRealMin(rank_time_min, IOProc);
+  amrex::ParallelDescriptor::ReduceRealMax(rank_time_max, IOProc);
+  amrex::ParallelDescriptor::ReduceRealMax(wall, IOProc);
+  amrex::ParallelDescriptor::ReduceRealMax(fab_bytes_hwm, IOProc);
+  amrex::ParallelDescriptor::ReduceRealSum(rhs, IOProc);
+
+  if (amrex::ParallelDescriptor::IOProcessor()) {
+    amrex::Real cell_updates = 0.0;
+    for (const amrex::Real cells : telemetry_cells) {
+      cell_updates += cells;
+    }
+
+    std::ostringstream rec;
+    rec << std::setprecision(8);
+    rec << "{\"step\": " << parent->levelSteps(0) << ", \"time\": " << cumtime
+        << ", \"dt\": " << parent->dtLevel(0) << ", \"wall\": " << wall
+        << ", \"phases\": {";
+    for (int phase = 0; phase < num_telemetry_phases; phase++) {
+      rec << (phase > 0 ? ", " : "") << "\"" << telemetry_phase_names[phase]
+          << "\": " << phase_max[phase];
+    }
+    rec << "}, \"cells\": [";
+    for (int lev = 0; lev < telemetry_cells.size(); lev++) {
+      rec << (lev > 0 ? ", " : "")
+          << static_cast<amrex::Long>(telemetry_cells[lev]);
+    }
+    rec << "], \"cell_updates\": " << static_cast<amrex::Long>(cell_updates)
+        << ", \"cell_updates_per_s\": "
+        << (wall > 0.0 ? cell_updates / wall : 0.0)
+        << ", \"rhs_evals\": " << static_cast<amrex::Long>(rhs)
+        << ", \"rank_time_min\": " << rank_time_min
+        << ", \"rank_time_max\": " << rank_time_max
+        << ", \"fab_bytes_hwm\": " << static_cast<amrex::Long>(fab_bytes_hwm)
+        << ", \"buffer_allocs\": " << LevelBuffers::num_allocated()
+        << ", \"buffer_reuses\": " << LevelBuffers::num_reused() << "}\n";
+
+    std::ofstream ofs(telemetry_file, std::ios::app);
+    if (!ofs.good()) {
+      amrex::Abort("Unable to open telemetry_file " + telemetry_file);
+    }
+    ofs << rec.str();
+  }
+
+  telemetry_time.fill(0.0);
+  telemetry_cells.clear();
+  telemetry_rhs = 0.0;
+  amrex::ResetTotalBytesAllocatedInFabsHWM();
+  telemetry_step_start = amrex::ParallelDescriptor::second();
+}
@@ -0,0 +1,236 @@
+#include <AMReX_Random.H>
+
+#include "PeleC.H"
+#include "TransportTable.H"
+
+void
+pc_get_transport_coeffs(
+  const amrex::Box& bx,
+  const amrex::Array4<const amrex::Real>& q_Y,
+  const amrex::Array4<const amrex::Real>& q_T,
+  const amrex::Array4<const amrex::Real>& q_rho,
+  const amrex::Array4<amrex::Real>& rhoD,
+  const amrex::Array4<amrex::Real>& mu,
+  const amrex::Array4<amrex::Real>& xi,
+  const amrex::Array4<amrex::Real>& lam,
+  pele::physics::transport::TransParm const* trans_parm,
+  const TransportTable& table)
+{
+  if (table.nT > 0) {
+    const TransportTable ltable = table;
+    amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+      amrex::Real Y[NUM_SPECIES];
+      amrex::Real D[NUM_SPECIES];
+      for (int n = 0; n < NUM_SPECIES; ++n) {
+        Y[n] = q_Y(i, j, k, n);
+      }
+      amrex::Real muloc = 0.0, xiloc = 0.0, lamloc = 0.0;
+      pc_transport(
+        true, true, true, true, q_T(i, j, k), q_rho(i, j, k), Y, D, muloc,
+        xiloc, lamloc, trans_parm, ltable);
+      for (int n = 0; n < NUM_SPECIES; ++n) {
+        rhoD(i, j, k, n) = D[n];
+      }
+      mu(i, j, k) = muloc;
+      xi(i, j, k) = xiloc;
+      lam(i, j, k) = lamloc;
+    });
+  } else {
+    amrex::launch(bx, [=] AMREX_GPU_DEVICE(amrex::Box const& tbx) {
+      auto trans = pele::physics::PhysicsType::transport();
+      trans.get_transport_coeffs(
+        tbx, q_Y, q_T, q_rho, rhoD, mu, xi, lam, trans_parm);
+    });
+  }
+}
+
+void
+PeleC::init_transport_table()
+{
+  BL_PROFILE("PeleC::init_transport_table()");
+
+#ifndef PELEC_USE_SIMPLE
+  amrex::Abort("use_transport_table requires the Simple transport model");
+#else
+  if (
+    transport_table_dT <= 0.0 ||
+    transport_table_Tmax <= transport_table_Tmin) {
+    amrex::Abort(
+      "transport_table_dT must be positive and transport_table_Tmax larger "
+      "than transport_table_Tmin");
+  }
+
+  const int nT =
+    static_cast<int>(std::ceil(
+      (transport_table_Tmax - transport_table_Tmin) / transport_table_dT)) +
+    1;
+  const amrex::Real dT =
+    (transport_table_Tmax - transport_table_Tmin) / (nT - 1);
+  const std::size_t nrow = static_cast<std::size_t>(nT) * NUM_SPECIES;
+  const std::size_t ntot = nrow * (3 + NUM_SPECIES);
+  auto* data = static_cast<amrex::Real*>(
+    amrex::The_Arena()->alloc(ntot * sizeof(amrex::Real)));
+
+  transport_table.nT = nT;
+  transport_table.Tmin = transport_table_Tmin;
+  transport_table.Tmax = transport_table_Tmax;
+  transport_table.dTinv = 1.0 / dT;
+  transport_table.mu = data;
+  transport_table.lam = data + nrow;
+  transport_table.xi = data + 2 * nrow;
+  transport_table.Dt = data + 3 * nrow;
+
+  // Each species j alone (up to the trace amounts) gives mu_j, lambda_j and
+  // xi_j, and the rhoD of every other species i in a bath of j
+  const TransportTable ltable = transport_table;
+  const amrex::Real Tmin = transport_table_Tmin;
+  pele::physics::transport::TransParm const* ltransparm =
+    pele::physics::transport::trans_parm_g;
+  amrex::ParallelFor(
+    nT * NUM_SPECIES, [=] AMREX_GPU_DEVICE(int idx) noexcept {
+      const int it = idx / NUM_SPECIES;
+      const int j = idx % NUM_SPECIES;
+      amrex::Real T = Tmin + it * dT;
+      amrex::Real rho = 1.0e-3;
+      amrex::Real Y[NUM_SPECIES] = {0.0};
+      amrex::Real D[NUM_SPECIES] = {0.0};
+      Y[j] = 1.0;
+      amrex::Real mu = 0.0, xi = 0.0, lam = 0.0;
+      auto trans = pele::physics::PhysicsType::transport();
+      trans.transport(
+        true, true, true, true, T, rho, Y, D, mu, xi, lam, ltransparm);
+      ltable.mu[idx] = mu;
+      ltable.lam[idx] = lam;
+      ltable.xi[idx] = xi;
+      amrex::Real* Dt = ltable.Dt + it * NUM_SPECIES * NUM_SPECIES;
+      for (int i = 0; i < NUM_SPECIES; ++i) {
+        Dt[i * NUM_SPECIES + j] = D[i];
+      }
+    });
+  amrex::Gpu::streamSynchronize();
+
+  amrex::Print() << "Transport table: " << nT << " temperatures in ["
+                 << transport_table_Tmin << ", " << transport_table_Tmax
+                 << "] K, " << ntot * sizeof(amrex::Real) / (1024.0 * 1024.0)
+                 << " MB\n";
+
+  check_transport_table();
+#endif
+}
+
+// Compare the tabulated and the PelePhysics transport properties on random
+// states, report the largest relative errors and the time taken by both
+void
+PeleC::check_transport_table()
+{
+  BL_PROFILE("PeleC::check_transport_table()");
+
+  const int nsamples = 4096;
+  const int nrep = 5;
+  const int nout = NUM_SPECIES + 3;
+
+  amrex::Vector<amrex::Real> h_T(nsamples);
+  amrex::Vector<amrex::Real> h_Y(nsamples * NUM_SPECIES);
+  for (int s = 0; s < nsamples; s++) {
+    h_T[s] = transport_table_Tmin +
+             (transport_table_Tmax - transport_table_Tmin) * amrex::Random();
+    amrex::Real sum = 0.0;
+    for (int n = 0; n < NUM_SPECIES; n++) {
+      // Leave out about half of the species
+      const amrex::Real y = amrex::Random();
+      h_Y[s * NUM_SPECIES + n] = y < 0.5 ? 0.0 : y;
+      sum += h_Y[s * NUM_SPECIES + n];
+    }
+    if (sum == 0.0) {
+      h_Y[s * NUM_SPECIES] = 1.0;
+      sum = 1.0;
+    }
+    for (int n = 0; n < NUM_SPECIES; n++) {
+      h_Y[s * NUM_SPECIES + n] /= sum;
+    }
+  }
+  amrex::Gpu::DeviceVector<amrex::Real> d_T(nsamples);
+  amrex::Gpu::DeviceVector<amrex::Real> d_Y(nsamples * NUM_SPECIES);
+  amrex::Gpu::copy(
+    amrex::Gpu::hostToDevice, h_T.begin(), h_T.end(), d_T.begin());
+  amrex::Gpu::copy(
+    amrex::Gpu::hostToDevice, h_Y.begin(), h_Y.end(), d_Y.begin());
+
+  pele::physics::transport::TransParm const* ltransparm =
+    pele::physics::transport::trans_parm_g;
+  const amrex::Real* T_ptr = d_T.data();
+  const amrex::Real* Y_ptr = d_Y.data();
+  auto evaluate = [=](const TransportTable& table, amrex::Real* out) {
+    amrex::ParallelFor(nsamples, [=] AMREX_GPU_DEVICE(int s) noexcept {
+      amrex::Real Y[NUM_SPECIES];
+      for (int n = 0; n < NUM_SPECIES; ++n) {
+        Y[n] = Y_ptr[s * NUM_SPECIES + n];
+      }
+      amrex::Real* o = out + s * nout;
+      pc_transport(
+        true, true, true, true, T_ptr[s], 1.0e-3, Y, o, o[NUM_SPECIES],
+        o[NUM_SPECIES + 1], o[NUM_SPECIES + 2], ltransparm, table);
+    });
+    amrex::Gpu::streamSynchronize();
+  };
+
+  amrex::Gpu::DeviceVector<amrex::Real> d_ref(nsamples * nout);
+  amrex::Gpu::DeviceVector<amrex::Real> d_tab(nsamples * nout);
+  const TransportTable no_table;
+  amrex::Real strt_time = amrex::ParallelDescriptor::second();
+  for (int rep = 0; rep < nrep; rep++) {
+    evaluate(no_table, d_ref.data());
+  }
+  const amrex::Real ref_time =
+    (amrex::ParallelDescriptor::second() - strt_time) / nrep;
+  strt_time = amrex::ParallelDescriptor::second();
+  for (int rep = 0; rep < nrep; rep++) {
+    evaluate(transport_table, d_tab.data());
+  }
+  const amrex::Real tab_time =
+    (amrex::ParallelDescriptor::second() - strt_time) / nrep;
+
+  amrex::Vector<amrex::Real> h_ref(nsamples * nout);
+  amrex::Vector<amrex::Real> h_tab(nsamples * nout);
+  amrex::Gpu::copy(
+    amrex::Gpu::deviceToHost, d_ref.begin(), d_ref.end(), h_ref.begin());
+  amrex::Gpu::copy(
+    amrex::Gpu::deviceToHost, d_tab.begin(), d_tab.end(), h_tab.begin());
+
+  // Largest relative errors in rhoD, mu, xi and lambda
+  amrex::Real err[4] = {0.0};
+  for (int s = 0; s < nsamples; s++) {
+    for (int n = 0; n < nout; n++) {
+      const amrex::Real a = h_ref[s * nout + n];
+      const amrex::Real b = h_tab[s * nout + n];
+      const amrex::Real e =
+        std::abs(a - b) / amrex::max<amrex::Real>(std::abs(a), 1.0e-300);
+      const int q = amrex::max(n - NUM_SPECIES + 1, 0);
+      err[q] = amrex::max(err[q], e);
+    }
+  }
+
+  amrex::Print() << "Transport table relative errors: rhoD " << err[0]
+                 << ", mu " << err[1] << ", xi " << err[2] << ", lambda "
+                 << err[3] << "\n"
+                 << "Transport table time per " << nsamples
+                 << " states: fits " << ref_time << " s, table " << tab_time
+                 << " s\n";
+
+  const amrex::Real max_err =
+    amrex::max(amrex::max(err[0], err[1]), amrex::max(err[2], err[3]));
+  if (max_err > transport_table_tol) {
+    amrex::Abort(
+      "Transport table error exceeds transport_table_tol, reduce "
+      "transport_table_dT");
+  }
+}
+
+void
+PeleC::close_transport_table()
+{
+  if (transport_table.nT > 0) {
+    amrex::The_Arena()->free(transport_table.mu);
+    transport_table = TransportTable();
+  }
+}
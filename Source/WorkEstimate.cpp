@@ -0,0 +1,166 @@
+#include "PeleC.H"
+
+// Per-box cost accounting for load balancing.
+//
+// Each phase of the step measures the wall time it spends on a tile and adds
+// it, times the weight of the phase, spread uniformly over the cells of the
+// tile, to Work_Estimate_Type. The spray phase is spread over the cells by
+// their number of particles instead. Amr then balances the grids on the sum
+// of the work estimates when amr.loadbalance_with_workestimates is set. The
+// time of each phase on this rank is also accumulated, to report the
+// imbalance of each phase across ranks at the end of the step.
+
+namespace {
+const char* const cost_phase_names[num_cost_phases] = {
+  "mol", "godunov", "react", "les", "spray", "sources"};
+} // namespace
+
+void
+PeleC::zero_box_costs()
+{
+  if (do_load_balance) {
+    get_new_data(Work_Estimate_Type).setVal(0.0);
+#ifdef AMREX_PARTICLES
+    if (
+      do_spray_particles && spray_particle_cost >= 0.0 &&
+      theSprayPC() != nullptr) {
+      add_particle_cost(spray_particle_cost);
+    }
+#endif
+  }
+  phase_cost.fill(0.0);
+}
+
+// Add the wall time since wt spent on the tile of mfi to the work estimates
+void
+PeleC::add_box_cost(
+  const int phase, const amrex::MFIter& mfi, const amrex::Real wt)
+{
+  if (!do_load_balance) {
+    return;
+  }
+
+  amrex::Gpu::streamSynchronize();
+  const amrex::Real elapsed = amrex::ParallelDescriptor::second() - wt;
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+  phase_cost[phase] += elapsed;
+
+  const amrex::Box vbox = mfi.tilebox();
+  get_new_data(Work_Estimate_Type)[mfi].plus<amrex::RunOn::Device>(
+    cost_phase_weights[phase] * elapsed / vbox.d_numPts(), vbox);
+}
+
+#ifdef AMREX_PARTICLES
+// Add per_particle times the number of spray particles in each cell of this
+// level to the work estimates, so that the spray cost follows the particles
+// within a box when the grids change
+void
+PeleC::add_particle_cost(const amrex::Real per_particle)
+{
+  amrex::MultiFab count(grids, dmap, 1, 0);
+  count.setVal(0.0);
+  theSprayPC()->Increment(count, level);
+  amrex::MultiFab::Saxpy(
+    get_new_data(Work_Estimate_Type),
+    cost_phase_weights[cost_spray] * per_particle, count, 0, 0, 1, 0);
+}
+
+// The particle routines do not loop over the boxes of the level, so the wall
+// time since wt is shared among the cells by their number of particles. With
+// a calibrated spray_particle_cost, the particles are instead charged once
+// per step in zero_box_costs and the time is only kept for the report.
+void
+PeleC::add_spray_cost(const amrex::Real wt)
+{
+  if (!do_load_balance) {
+    return;
+  }
+
+  const amrex::Real elapsed = amrex::ParallelDescriptor::second() - wt;
+  phase_cost[cost_spray] += elapsed;
+  if (spray_particle_cost >= 0.0) {
+    return;
+  }
+
+  const amrex::Long npart_local =
+    theSprayPC()->NumberOfParticlesAtLevel(level, true, true);
+  if (npart_local > 0) {
+    add_particle_cost(elapsed / npart_local);
+  }
+}
+
+// A redistribution moves the particles of level lbase and all finer levels,
+// so the wall time since wt is shared among the cells of these levels by
+// their number of particles.
+void
+PeleC::add_redistribute_cost(const int lbase, const amrex::Real wt)
+{
+  if (!do_load_balance) {
+    return;
+  }
+
+  const amrex::Real elapsed = amrex::ParallelDescriptor::second() - wt;
+  phase_cost[cost_spray] += elapsed;
+  if (spray_particle_cost >= 0.0) {
+    return;
+  }
+
+  const int finest_level = parent->finestLevel();
+  amrex::Long npart_local = 0;
+  for (int lev = lbase; lev <= finest_level; ++lev) {
+    npart_local += theSprayPC()->NumberOfParticlesAtLevel(lev, true, true);
+  }
+  if (npart_local > 0) {
+    for (int lev = lbase; lev <= finest_level; ++lev) {
+      getLevel(lev).add_particle_cost(elapsed / npart_local);
+    }
+  }
+}
+#endif
+
+// Print the load imbalance, max over ranks / mean over ranks, of the time
+// spent in each phase in this step, of their total, and of the work
+// estimates that the next load balance distributes
+void
+PeleC::report_box_costs()
+{
+  if (!do_load_balance || verbose <= 0) {
+    return;
+  }
+
+  const int IOProc = amrex::ParallelDescriptor::IOProcessorNumber();
+  const int ncosts = num_cost_phases + 2;
+  amrex::Array<amrex::Real, num_cost_phases + 2> cost_max = {{0.0}};
+  for (int phase = 0; phase < num_cost_phases; phase++) {
+    cost_max[phase] = phase_cost[phase];
+    cost_max[num_cost_phases] += phase_cost[phase];
+  }
+  cost_max[num_cost_phases + 1] =
+    get_new_data(Work_Estimate_Type).sum(0, true);
+  amrex::Array<amrex::Real, num_cost_phases + 2> cost_sum = cost_max;
+  amrex::ParallelDescriptor::ReduceRealMax(cost_max.data(), ncosts, IOProc);
+  amrex::ParallelDescriptor::ReduceRealSum(cost_sum.data(), ncosts, IOProc);
+
+  if (amrex::ParallelDescriptor::IOProcessor()) {
+    const int nprocs = amrex::ParallelDescriptor::NProcs();
+    amrex::Print() << "PeleC::advance() at level " << level
+                   << ": load imbalance (max / mean time) per phase:";
+    for (int phase = 0; phase < num_cost_phases; phase++) {
+      if (cost_sum[phase] > 0.0) {
+        amrex::Print() << " " << cost_phase_names[phase] << " "
+                       << cost_max[phase] * nprocs / cost_sum[phase] << " ("
+                       << cost_max[phase] << " s)";
+      }
+    }
+    const char* const sum_names[2] = {"total", "work estimate"};
+    for (int n = num_cost_phases; n < ncosts; n++) {
+      if (cost_sum[n] > 0.0) {
+        amrex::Print() << ", " << sum_names[n - num_cost_phases] << " "
+                       << cost_max[n] * nprocs / cost_sum[n];
+      }
+    }
+    amrex::Print() << "\n";
+  }
+}